@@ -38,6 +38,18 @@ TEST_SUITE("Bench multi-threading Evaluator::evaluate()") {
         );
     }
 
+    auto evalMeasureBatch(ankerl::nanobench::Bench& bench) -> void {
+        std::vector<Layout> layouts;
+        for (uz i = 0; i < NUM_SAMPLES; ++i) {
+            layouts.emplace_back(manager.create());
+        }
+        std::vector<fz> losses(NUM_SAMPLES);
+        bench.run(
+            "measureBatch() - baseline",
+            [&]() -> void { evaluator.measureBatch(layouts, losses); }
+        );
+    }
+
     auto evalAnalyze(ankerl::nanobench::Bench& bench) -> void {
         const Samples samples = createSamples(manager);
         bench.run(
@@ -50,6 +62,55 @@ TEST_SUITE("Bench multi-threading Evaluator::evaluate()") {
         );
     }
 
+    auto evalUpdate(ankerl::nanobench::Bench& bench) -> void {
+        const Samples parents = createSamples(manager);
+        const Samples children = createSamples(manager);
+        for (uz i = 0; i < NUM_SAMPLES; ++i) {
+            evaluator.analyze(*parents[i]);
+        }
+        bench.run(
+            "update() - baseline",
+            [&]() -> void {
+                for (uz i = 0; i < NUM_SAMPLES; ++i) {
+                    const auto [pos1, pos2] = manager.mutate(*children[i], *parents[i]);
+                    evaluator.update(*children[i], *parents[i], pos1, pos2);
+                }
+            }
+        );
+    }
+
+    // 语料包含完整的分布, 因此 SeqCost 使用稠密表示 //
+    auto evalUpdateDense(ankerl::nanobench::Bench& bench) -> void {
+        const uz task_id = Utils::taskIdOf(MetricId::SeqCost, Language::Chinese);
+        const Samples parents = createSamples(manager);
+        const Samples children = createSamples(manager);
+        for (uz i = 0; i < NUM_SAMPLES; ++i) {
+            evaluator.analyze(*parents[i], task_id);
+        }
+        bench.run(
+            "update() - SeqCost, random parents",
+            [&]() -> void {
+                for (uz i = 0; i < NUM_SAMPLES; ++i) {
+                    const auto [pos1, pos2] = manager.mutate(*children[i], *parents[i]);
+                    evaluator.update(*children[i], *parents[i], pos1, pos2, task_id);
+                }
+            }
+        );
+        // 与退火相同, 每次只在上一个布局的基础上交换一对按键
+        Sample curr = *parents[0];
+        Sample next = curr;
+        bench.run(
+            "update() - SeqCost, successive swaps",
+            [&]() -> void {
+                for (uz i = 0; i < NUM_SAMPLES; ++i) {
+                    const auto [pos1, pos2] = manager.mutate(next, curr);
+                    evaluator.update(next, curr, pos1, pos2, task_id);
+                    std::swap(curr, next);
+                }
+            }
+        );
+    }
+
     auto evalMeasureMt(ankerl::nanobench::Bench& bench, const uz num_threads) -> void {
         const Samples samples = createSamples(manager);
         bench.run(
@@ -90,12 +151,15 @@ TEST_SUITE("Bench multi-threading Evaluator::evaluate()") {
         b.performanceCounters(true);
 
         evalMeasure(b);
+        evalMeasureBatch(b);
         for (uz i = 2; i <= MAX_THREADS; ++i) {
             omp_set_num_threads(static_cast<int>(i));
             evalMeasureMt(b, i);
         }
 
         evalAnalyze(b);
+        evalUpdate(b);
+        evalUpdateDense(b);
         for (uz i = 2; i <= MAX_THREADS; ++i) {
             omp_set_num_threads(static_cast<int>(i));
             evalAnalyzeMt(b, i);
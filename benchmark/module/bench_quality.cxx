@@ -0,0 +1,185 @@
+#include <omp.h>
+#include <chrono>
+#include <fstream>
+#include <functional>
+
+#include <doctest/doctest.h>
+
+#include "../../src/module/optimizer/o_pool.hxx"
+#include "../../src/module/optimizer/annealer.hxx"
+
+static constexpr size_t NUM_SEEDS = 10;
+static constexpr double TIME_BUDGET = 60.0; // 每次运行的时间预算 (秒)
+static constexpr double TARGET_TOLERANCE = 1e-4; // 损失不超过 参考损失 x (1 + 容差) 时视为达到目标
+
+namespace clubmoss::optimizer::bench {
+
+// 解的质量随时间的变化: 以若干个固定种子运行各个搜索引擎, 记录各时间点上的最优损失,
+// 并统计达到参考损失所需时间的中位数与 90 分位数. 参考损失取自 cache/status.toml 中的
+// reference_loss 字段, 由预处理之后的 Optimizer::search() 记录为迄今找到的最优损失;
+// 没有该字段时, 以所有运行中的最优损失作为参考.
+// 与 Optimizer::search() 使用相同的搜索引擎, 但不读写检查点, 也不覆盖 cache/result/ 下的结果.
+// 完整运行约需 20 分钟, 因此默认跳过, 需要时以 --no-skip 运行.
+
+TEST_SUITE("Bench solution quality versus time") {
+
+    using Clock = std::chrono::steady_clock;
+
+    class AnnealerWrapper : public Annealer {
+    public:
+        auto searchOnce() noexcept -> fz {
+            bests_.clear();
+            return search();
+        }
+    };
+
+    // 一次运行中最优损失的变化过程 //
+    struct Trace {
+        std::vector<std::pair<double, fz>> points{}; // (秒, 最优损失), 只记录改进
+
+        [[nodiscard]] auto lossAt(const double seconds) const -> fz {
+            fz loss = std::numeric_limits<fz>::infinity();
+            for (const auto& [t, l] : points) {
+                if (t > seconds) break;
+                loss = l;
+            }
+            return loss;
+        }
+
+        [[nodiscard]] auto timeToReach(const fz target) const -> double {
+            for (const auto& [t, l] : points) {
+                if (l <= target) return t;
+            }
+            return std::numeric_limits<double>::infinity();
+        }
+    };
+
+    // 一个搜索引擎: 每次调用执行一个完整的搜索单元 (一个样本池或一轮退火), 返回其最优损失
+    using Engine = std::function<std::function<fz()>()>;
+
+    static const std::vector<std::pair<std::string, Engine>> ENGINES{
+        {
+            "pool", [] -> std::function<fz()> {
+                auto pool = std::make_shared<Pool>();
+                pool->setSize(Resources::STATUS.at("pool_size").as_integer());
+                return [pool] -> fz { return pool->search(); };
+            }
+        },
+        {
+            "annealing", [] -> std::function<fz()> {
+                auto annealer = std::make_shared<AnnealerWrapper>();
+                return [annealer] -> fz { return annealer->searchOnce(); };
+            }
+        },
+    };
+
+    auto run(const Engine& engine, const uint64_t seed) -> Trace {
+        layout::Manager::setSeed(seed);
+        const std::function<fz()> step = engine();
+        Trace trace;
+        fz best_loss = std::numeric_limits<fz>::infinity();
+        const Clock::time_point start = Clock::now();
+        double elapsed = 0.0;
+        while (elapsed < TIME_BUDGET) {
+            const fz loss = step();
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if (loss < best_loss) {
+                best_loss = loss;
+                trace.points.emplace_back(elapsed, loss);
+            }
+        }
+        layout::Manager::setSeed(std::nullopt);
+        return trace;
+    }
+
+    // 最近秩法求分位数, 未达到目标的运行记为无穷大
+    auto percentile(std::vector<double> values, const double p) -> double {
+        std::ranges::sort(values);
+        const auto rank = static_cast<uz>(std::ceil(p * static_cast<double>(values.size())));
+        return values[std::clamp(rank, 1uz, values.size()) - 1];
+    }
+
+    auto join(const std::vector<std::string>& items) -> std::string {
+        std::string result;
+        for (const auto& [i, item] : items | std::views::enumerate) {
+            result += i == 0 ? item : ", " + item;
+        }
+        return result;
+    }
+
+    auto formatSeconds(const double seconds) -> std::string {
+        return std::isinf(seconds) ? std::string("null") : std::format("{:.3f}", seconds);
+    }
+
+    TEST_CASE("bench solution quality versus time" * doctest::skip()) {
+        static constexpr std::array CHECKPOINTS{1.0, 2.0, 5.0, 10.0, 20.0, 30.0, 60.0};
+
+        std::vector<std::vector<Trace>> traces(ENGINES.size());
+        for (const auto& [e, entry] : ENGINES | std::views::enumerate) {
+            for (uint64_t seed = 1; seed <= NUM_SEEDS; ++seed) {
+                traces[e].push_back(run(entry.second, seed));
+                fmt::println(
+                    stderr, "[{:s}, seed {: >2d}]: best loss = {:8.5f}",
+                    entry.first, seed, traces[e].back().points.back().second
+                );
+            }
+        }
+
+        fz reference = std::numeric_limits<fz>::infinity();
+        if (Resources::STATUS.contains("reference_loss")) {
+            reference = Resources::STATUS.at("reference_loss").as_floating();
+        } else {
+            for (const std::vector<Trace>& runs : traces) {
+                for (const Trace& trace : runs) {
+                    reference = std::min(reference, trace.points.back().second);
+                }
+            }
+            fmt::println(stderr, "No reference_loss in cache/status.toml, using the best loss found: {:8.5f}", reference);
+        }
+        const fz target = reference * (1.0 + TARGET_TOLERANCE);
+
+        const std::string dir = Utils::absPath("cache/bench");
+        std::filesystem::create_directories(dir);
+        std::ofstream os(std::format("{:s}/quality.json", dir), std::ios::out | std::ios::trunc);
+        os << std::format("{{\"reference_loss\": {:.8f}, \"time_budget\": {:.1f}, \"engines\": [\n", reference, TIME_BUDGET);
+
+        for (const auto& [e, entry] : ENGINES | std::views::enumerate) {
+            const std::vector<Trace>& runs = traces[e];
+            std::vector<double> times;
+            for (const Trace& trace : runs) {
+                times.push_back(trace.timeToReach(target));
+            }
+            const double median = percentile(times, 0.5);
+            const double p90 = percentile(times, 0.9);
+            const auto reached = std::ranges::count_if(times, [](const double t) { return not std::isinf(t); });
+
+            fmt::println(
+                stderr, "{:s}: reached target in {:d}/{:d} runs, median = {:s} s, p90 = {:s} s",
+                entry.first, reached, runs.size(), formatSeconds(median), formatSeconds(p90)
+            );
+
+            std::vector<std::string> checkpoints;
+            for (const double t : CHECKPOINTS) {
+                checkpoints.push_back(std::format("{:.1f}", t));
+            }
+            std::vector<std::string> curves;
+            for (const Trace& trace : runs) {
+                std::vector<std::string> losses;
+                for (const double t : CHECKPOINTS) {
+                    const fz loss = trace.lossAt(t);
+                    losses.push_back(std::isinf(loss) ? std::string("null") : std::format("{:.8f}", loss));
+                }
+                curves.push_back(std::format("[{:s}]", join(losses)));
+            }
+            os << std::format(
+                "  {{\"name\": \"{:s}\", \"seeds\": {:d}, \"reached\": {:d}, "
+                "\"median_seconds\": {:s}, \"p90_seconds\": {:s},\n   \"checkpoints\": [{:s}],\n   \"best_loss_at\": [{:s}]}}{:s}\n",
+                entry.first, runs.size(), reached, formatSeconds(median), formatSeconds(p90),
+                join(checkpoints), join(curves), e + 1 < static_cast<std::ptrdiff_t>(ENGINES.size()) ? "," : ""
+            );
+        }
+        os << "]}\n";
+    }
+}
+
+}
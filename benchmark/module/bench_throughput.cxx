@@ -0,0 +1,114 @@
+#include <omp.h>
+#include <thread>
+#include <fstream>
+
+#include <nanobench.h>
+#include <doctest/doctest.h>
+
+#include "../../src/module/optimizer/o_pool.hxx"
+
+static constexpr size_t NUM_LAYOUTS = 4800;
+static constexpr size_t NUM_EPOCHS = 20;
+
+namespace clubmoss::throughput::bench {
+
+// 端到端吞吐量: 使用 data/ 下的语料, 在不同的线程数与样本池大小下运行完整的评估与搜索,
+// 结果以 JSON 格式写入 cache/bench/, 用于估算硬件需求以及对比不同版本的性能.
+
+TEST_SUITE("Bench end-to-end throughput") {
+
+    class PoolWrapper : public optimizer::Pool {
+    public:
+        // 与 search() 相同的迭代过程, 但固定代数, 以便不同版本之间的结果可以比较
+        auto runEpochs(const uz num_epochs) noexcept -> void {
+            start();
+            for (uz epoch = 0; epoch < num_epochs; ++epoch) {
+                updateAndEvaluateSamples();
+                selectSamples();
+            }
+        }
+
+        [[nodiscard]] auto half() const noexcept -> uz {
+            return half_;
+        }
+    };
+
+    // 1, 2, 4, ... 直到硬件线程数
+    auto threadCounts() -> std::vector<uz> {
+        const uz max_threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<uz> counts;
+        for (uz n = 1; n < max_threads; n *= 2) {
+            counts.push_back(n);
+        }
+        counts.push_back(max_threads);
+        return counts;
+    }
+
+    auto saveJson(ankerl::nanobench::Bench& bench, const std::string_view file_name) -> void {
+        const std::string dir = Utils::absPath("cache/bench");
+        std::filesystem::create_directories(dir);
+        const std::string path = std::format("{:s}/{:s}", dir, file_name);
+        std::ofstream os(path, std::ios::out | std::ios::trunc);
+        bench.render(ankerl::nanobench::templates::json(), os);
+        fmt::println(stderr, "Results saved to \"{:s}\".", path);
+    }
+
+    TEST_CASE("bench Evaluator::analyze() throughput") {
+        layout::Manager manager;
+        std::vector<Sample> samples;
+        for (uz i = 0; i < NUM_LAYOUTS; ++i) {
+            samples.emplace_back(manager.create());
+        }
+
+        ankerl::nanobench::Bench b;
+        b.title("Evaluator::analyze()")
+         .unit("layout")
+         .batch(NUM_LAYOUTS)
+         .relative(true)
+         .warmup(2)
+         .minEpochIterations(5);
+        b.performanceCounters(true);
+
+        for (const uz num_threads : threadCounts()) {
+            omp_set_num_threads(static_cast<int>(num_threads));
+            std::vector<Evaluator> evaluators(num_threads);
+            b.run(
+                fmt::format("{: >3d} threads", num_threads).c_str(),
+                [&]() -> void {
+                    #pragma omp parallel for schedule(guided) shared(samples, evaluators) default (none)
+                    for (uz i = 0; i < NUM_LAYOUTS; ++i) {
+                        evaluators[static_cast<uz>(omp_get_thread_num())].analyze(samples[i]);
+                    }
+                }
+            );
+        }
+        saveJson(b, "evaluator_analyze.json");
+    }
+
+    TEST_CASE("bench optimizer::Pool epochs throughput") {
+        for (const uz pool_size : {1200uz, 2400uz, 4800uz}) {
+            PoolWrapper pool;
+            pool.setSize(pool_size);
+
+            // 每一代评估 half 个新样本, 因此 layouts/s = epochs/s x half
+            ankerl::nanobench::Bench b;
+            b.title(fmt::format("Pool epochs (size = {:d}, {:d} layouts per epoch)", pool_size, pool.half()))
+             .unit("epoch")
+             .batch(NUM_EPOCHS)
+             .relative(true)
+             .epochs(3);
+            b.performanceCounters(true);
+
+            for (const uz num_threads : threadCounts()) {
+                omp_set_num_threads(static_cast<int>(num_threads));
+                b.run(
+                    fmt::format("{: >3d} threads", num_threads).c_str(),
+                    [&]() -> void { pool.runEpochs(NUM_EPOCHS); }
+                );
+            }
+            saveJson(b, std::format("pool_epochs_{:d}.json", pool_size));
+        }
+    }
+}
+
+}
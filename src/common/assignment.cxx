@@ -0,0 +1,94 @@
+#include "assignment.hxx"
+
+namespace clubmoss {
+
+/**
+ * @brief 求总代价最小的指派.
+ * @param costs n x n 的代价矩阵, 按行存储, costs[i * n + j] 为将第 i 行指派给第 j 列的代价.
+ * @param n 矩阵的阶数.
+ * @return 每一行指派到的列.
+ **/
+auto Assignment::minimize(const std::span<const fz> costs, const uz n) -> std::vector<uz> {
+    return solve(costs, n, 1.0);
+}
+
+/**
+ * @brief 求总代价最大的指派, 参数与返回值同 minimize().
+ **/
+auto Assignment::maximize(const std::span<const fz> costs, const uz n) -> std::vector<uz> {
+    return solve(costs, n, -1.0);
+}
+
+/**
+ * @brief 计算一个指派的总代价.
+ **/
+auto Assignment::totalOf(const std::span<const fz> costs, const uz n, const std::span<const uz> assignment) noexcept -> fz {
+    fz total = 0.0;
+    for (uz i = 0; i < n; ++i) {
+        total += costs[i * n + assignment[i]];
+    }
+    return total;
+}
+
+/**
+ * @brief 逐行加入, 沿缩减代价下的最短增广路更新匹配, 并维护行与列的对偶变量.
+ * @param sign 代价的符号, 为 -1 时求最大值.
+ * @note 下标 0 为虚拟的列, 实际的行与列从 1 开始编号.
+ **/
+auto Assignment::solve(const std::span<const fz> costs, const uz n, const fz sign) -> std::vector<uz> {
+    assert(costs.size() == n * n);
+    constexpr fz INF = std::numeric_limits<fz>::infinity();
+
+    std::vector<fz> u(n + 1, 0.0), v(n + 1, 0.0); // 行与列的对偶变量
+    std::vector<uz> row_of(n + 1, 0); // 与每一列匹配的行
+    std::vector<uz> way(n + 1, 0); // 最短路树中每一列的前驱列
+
+    for (uz i = 1; i <= n; ++i) {
+        row_of[0] = i;
+        uz col = 0;
+        std::vector<fz> min_v(n + 1, INF);
+        std::vector<bool> used(n + 1, false);
+        do {
+            used[col] = true;
+            const uz row = row_of[col];
+            fz delta = INF;
+            uz next = 0;
+            for (uz j = 1; j <= n; ++j) {
+                if (used[j]) continue;
+                const fz reduced = sign * costs[(row - 1) * n + (j - 1)] - u[row] - v[j];
+                if (reduced < min_v[j]) {
+                    min_v[j] = reduced;
+                    way[j] = col;
+                }
+                if (min_v[j] < delta) {
+                    delta = min_v[j];
+                    next = j;
+                }
+            }
+            for (uz j = 0; j <= n; ++j) {
+                if (used[j]) {
+                    u[row_of[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    min_v[j] -= delta;
+                }
+            }
+            col = next;
+        } while (row_of[col] != 0);
+
+        // 沿前驱回溯, 翻转增广路上的匹配
+        do {
+            const uz prev = way[col];
+            row_of[col] = row_of[prev];
+            col = prev;
+        } while (col != 0);
+    }
+
+    std::vector<uz> assignment(n, 0);
+    for (uz j = 1; j <= n; ++j) {
+        assignment[row_of[j] - 1] = j - 1;
+    }
+    return assignment;
+}
+
+}
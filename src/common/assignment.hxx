@@ -0,0 +1,24 @@
+#ifndef CLUBMOSS_ASSIGNMENT_HXX
+#define CLUBMOSS_ASSIGNMENT_HXX
+
+#include "utils.hxx"
+
+namespace clubmoss {
+
+// 线性指派问题的精确求解器 (Jonker-Volgenant 式的最短增广路算法, O(n^3)) //
+class Assignment {
+public:
+    Assignment() = delete;
+
+    static auto minimize(std::span<const fz> costs, uz n) -> std::vector<uz>;
+    static auto maximize(std::span<const fz> costs, uz n) -> std::vector<uz>;
+
+    static auto totalOf(std::span<const fz> costs, uz n, std::span<const uz> assignment) noexcept -> fz;
+
+private:
+    static auto solve(std::span<const fz> costs, uz n, fz sign) -> std::vector<uz>;
+};
+
+}
+
+#endif //CLUBMOSS_ASSIGNMENT_HXX
@@ -0,0 +1,86 @@
+#include "mapped_file.hxx"
+
+#if defined(_WIN32)
+#    define WIN32_LEAN_AND_MEAN
+#    define NOMINMAX
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <unistd.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#endif
+
+namespace clubmoss {
+
+/**
+ * @param path 文件的绝对路径.
+ * @note 文件不存在或无法映射时, isOpen() 返回 false.
+ **/
+MappedFile::MappedFile(const std::string& path) {
+#if defined(_WIN32)
+    const HANDLE file = CreateFileA(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) return;
+    LARGE_INTEGER size{};
+    if (GetFileSizeEx(file, &size) and size.QuadPart > 0) {
+        if (const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+            data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            size_ = data_ ? static_cast<uz>(size.QuadPart) : 0;
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 and st.st_size > 0) {
+        if (void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            addr != MAP_FAILED) {
+            data_ = static_cast<const char*>(addr);
+            size_ = static_cast<uz>(st.st_size);
+        }
+    }
+    ::close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+auto MappedFile::isOpen() const noexcept -> bool {
+    return data_ != nullptr;
+}
+
+auto MappedFile::bytes() const noexcept -> std::string_view {
+    return {data_, size_};
+}
+
+auto MappedFile::unmap() noexcept -> void {
+    if (data_ == nullptr) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(data_);
+#else
+    ::munmap(const_cast<char*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+}
@@ -0,0 +1,32 @@
+#ifndef CLUBMOSS_MAPPED_FILE_HXX
+#define CLUBMOSS_MAPPED_FILE_HXX
+
+#include "utils.hxx"
+
+namespace clubmoss {
+
+// 以只读方式映射到内存的文件 //
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] auto isOpen() const noexcept -> bool;
+    [[nodiscard]] auto bytes() const noexcept -> std::string_view;
+
+private:
+    const char* data_{nullptr};
+    uz size_{0};
+
+    auto unmap() noexcept -> void;
+};
+
+}
+
+#endif //CLUBMOSS_MAPPED_FILE_HXX
@@ -39,6 +39,8 @@ using Pos = u8; // 键位(编号), ∈ [0, 29]
 using Col = u8; // 列号, ∈ [0, 9]
 using Row = u8; // 行号, ∈ [0, 2]
 
+using Hash = uint64_t; // 布局的 Zobrist 哈希值
+
 struct Key final {
     Cap cap{0};
     Pos pos{0};
@@ -81,6 +81,18 @@ auto Utils::posOf(const Row row, const Col col) noexcept -> Pos {
     return row * COL_COUNT + col;
 }
 
+/**
+ * @brief 键位 -> 手指.
+ * @param pos 键位.
+ * @note 中间两列分别由左右手食指负责.
+ **/
+auto Utils::fingerOf(const Pos pos) noexcept -> uz {
+    const Col col = colOf(pos);
+    if (col == 4) [[unlikely]] return Finger::LeftIndex;
+    if (col == 5) [[unlikely]] return Finger::RightIndex;
+    return col;
+}
+
 auto Utils::taskIdOf(const MetricId m, const Language l) noexcept -> uz {
     return m * Language::_size() + l;
 }
@@ -102,4 +114,33 @@ auto Utils::toSnakeCase(const std::string_view pascal_case) -> std::string {
     return str;
 }
 
+/**
+ * @brief 计算字节序列的 FNV-1a 哈希值.
+ * @param bytes 字节序列.
+ * @param hash 初始值, 用于串联多段字节序列.
+ * @return 哈希值.
+ **/
+auto Utils::fnv1a(const std::string_view bytes, Hash hash) noexcept -> Hash {
+    for (const char c : bytes) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief 计算若干文件内容的指纹, 用于判断由这些文件生成的缓存是否过期.
+ * @param sub_paths 文件相对于项目根目录的路径.
+ * @return 指纹, 不存在的文件视为空文件.
+ **/
+auto Utils::fingerprintOf(const std::initializer_list<std::string_view> sub_paths) -> Hash {
+    Hash hash = FNV_OFFSET;
+    for (const std::string_view sub_path : sub_paths) {
+        std::ifstream is(absPath(sub_path), std::ios::in | std::ios::binary);
+        const std::string content(std::istreambuf_iterator<char>(is), {});
+        hash = fnv1a(content, hash);
+        hash = fnv1a("\xFF", hash); // 分隔相邻的文件
+    }
+    return hash;
+}
+
 }
@@ -1,19 +1,25 @@
 #ifndef CLUBMOSS_UTILS_HXX
 #define CLUBMOSS_UTILS_HXX
 
+#include <new>
 #include <map>
 #include <set>
+#include <span>
 #include <array>
+#include <tuple>
 #include <vector>
 #include <bitset>
 #include <string>
 #include <format>
 #include <ranges>
 #include <memory>
+#include <numeric>
+#include <cassert>
 #include <utility>
 #include <fstream>
 #include <iostream>
 #include <filesystem>
+#include <unordered_set>
 
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/base_sink.h>
@@ -49,6 +55,34 @@ static constexpr uz TASK_COUNT = MetricId::_size() * Language::_size();
 
 using namespace toml::literals::toml_literals;
 
+// 按缓存行对齐的分配器, 用于连续存储的热点数据 //
+template <typename T, uz ALIGN = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, ALIGN>; };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, ALIGN>&) noexcept {}
+
+    auto allocate(const uz n) -> T* {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ALIGN}));
+    }
+
+    auto deallocate(T* p, uz) noexcept -> void {
+        ::operator delete(p, std::align_val_t{ALIGN});
+    }
+
+    template <typename U>
+    auto operator==(const AlignedAllocator<U, ALIGN>&) const noexcept -> bool { return true; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
 class Utils final {
 public:
     static auto absPath(std::string_view sub_path) -> std::string;
@@ -56,11 +90,15 @@ public:
     static auto colOf(Pos) noexcept -> Col;
     static auto rowOf(Pos) noexcept -> Row;
     static auto posOf(Row, Col) noexcept -> Pos;
+    static auto fingerOf(Pos) noexcept -> uz;
 
     static auto taskIdOf(MetricId, Language) noexcept -> uz;
 
     static auto toSnakeCase(std::string_view pascal_case) -> std::string;
 
+    static auto fnv1a(std::string_view bytes, Hash hash = FNV_OFFSET) noexcept -> Hash;
+    static auto fingerprintOf(std::initializer_list<std::string_view> sub_paths) -> Hash;
+
     template <typename INT> requires std::is_integral_v<INT>
     static auto isLegalCap(const INT cap) noexcept -> bool {
         return (cap >= 'A' and cap <= 'Z') or
@@ -89,10 +127,13 @@ public:
     }
 
 private:
+    static constexpr Hash FNV_OFFSET{0xCBF29CE484222325};
+    static constexpr Hash FNV_PRIME{0x100000001B3};
+
     using FileNames = std::vector<std::string>;
     using RequiredFiles = std::pair<std::string, FileNames>;
     inline static const std::vector<RequiredFiles> REQUIRED_FILES{
-        {"conf", {"layout.toml", "metric.toml", "score.toml"}},
+        {"conf", {"layout.toml", "metric.toml", "score.toml", "search.toml"}},
         {"data/chinese", {"char.toml", "pair.toml", "seq.toml"}},
         {"data/english", {"char.toml", "pair.toml", "seq.toml"}},
         {"cache", {"status.toml"}},
@@ -4,6 +4,23 @@ namespace clubmoss {
 
 using Marks = std::bitset<MAX_KEY_CODE>;
 
+// Zobrist 随机数表, ZOBRIST[pos][cap] 对应[键位]pos上放置[键值]cap
+// 键值 0 表示空位, 其随机数为 0, 因此未初始化的布局哈希值为 0
+static constexpr auto ZOBRIST = [] -> auto {
+    std::array<std::array<Hash, MAX_KEY_CODE>, KEY_COUNT> table{};
+    Hash state = 0x636C75626D6F7373ull; // "clubmoss"
+    for (auto& row : table) {
+        for (Hash& value : row | std::views::drop(1)) {
+            // SplitMix64
+            Hash z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0XBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0X94D049BB133111EBull;
+            value = z ^ (z >> 31);
+        }
+    }
+    return table;
+}();
+
 /**
  * @brief 仅供内部使用，用于构造一个未初始化的 Layout 对象.
  * @note 直接操作未初始化的 Layout 可能导致未定义行为.
@@ -50,16 +67,6 @@ void Layout::loadFromSeq(const std::string_view str) {
     }
 }
 
-auto Layout::getCap(const Pos pos) const noexcept -> Cap {
-    assert(Utils::isLegalPos(pos));
-    return key_map_[pos];
-}
-
-auto Layout::getPos(const Cap cap) const noexcept -> Pos {
-    assert(Utils::isLegalCap(cap));
-    return key_map_[cap];
-}
-
 auto Layout::toString() const noexcept -> std::string {
     auto caps = key_map_ | std::views::take(KEY_COUNT);
     return {caps.begin(), caps.end()};
@@ -74,6 +81,7 @@ auto Layout::toString() const noexcept -> std::string {
 auto Layout::setKey(const Cap cap, const Pos pos) noexcept -> void {
     assert(Utils::isLegalCap(cap));
     assert(Utils::isLegalPos(pos));
+    hash_ ^= ZOBRIST[pos][key_map_[pos]] ^ ZOBRIST[pos][cap];
     key_map_[cap] = pos;
     key_map_[pos] = cap;
 }
@@ -86,6 +94,9 @@ auto Layout::setKey(const Cap cap, const Pos pos) noexcept -> void {
 auto Layout::swap2Keys(const Pos pos1, const Pos pos2) noexcept -> void {
     assert(Utils::isLegalPos(pos1));
     assert(Utils::isLegalPos(pos2));
+    const Cap cap1 = key_map_[pos1], cap2 = key_map_[pos2];
+    hash_ ^= ZOBRIST[pos1][cap1] ^ ZOBRIST[pos1][cap2];
+    hash_ ^= ZOBRIST[pos2][cap2] ^ ZOBRIST[pos2][cap1];
     std::swap(key_map_[pos1], key_map_[pos2]);
     std::swap(key_map_[getCap(pos1)], key_map_[getCap(pos2)]);
 }
@@ -103,7 +114,7 @@ auto Layout::operator<=>(const Layout& other) const noexcept -> std::strong_orde
 }
 
 auto Layout::operator==(const Layout& other) const noexcept -> bool {
-    return this->key_map_ == other.key_map_;
+    return this->hash_ == other.hash_ and this->key_map_ == other.key_map_;
 }
 
 auto Layout::isValid() const noexcept -> bool {
@@ -10,6 +10,10 @@ namespace layout {
     class Area;
 }
 
+namespace optimizer {
+    class Enumerator;
+}
+
 // 键盘布局 //
 class Layout {
 public:
@@ -17,6 +21,7 @@ public:
 
     [[nodiscard]] auto getCap(Pos) const noexcept -> Cap;
     [[nodiscard]] auto getPos(Cap) const noexcept -> Pos;
+    [[nodiscard]] auto getHash() const noexcept -> Hash;
 
     [[nodiscard]] auto toString() const noexcept -> std::string;
     [[nodiscard]] auto isValid() const noexcept -> bool;
@@ -28,6 +33,9 @@ protected:
     // 按键列表, 存储了[键值]与[键位]的双向映射
     std::array<u8, MAX_KEY_CODE> key_map_{};
 
+    // 布局的 Zobrist 哈希值, 随 setKey() 与 swap2Keys() 增量地更新
+    Hash hash_{0};
+
     Layout();
 
     auto setKey(Cap, Pos) noexcept -> void;
@@ -54,8 +62,24 @@ private:
 
     friend class layout::Manager;
     friend class layout::Area;
+    friend class optimizer::Enumerator;
 };
 
+// 查询位于热路径上, 因此在头文件中内联定义 //
+inline auto Layout::getCap(const Pos pos) const noexcept -> Cap {
+    assert(Utils::isLegalPos(pos));
+    return key_map_[pos];
+}
+
+inline auto Layout::getPos(const Cap cap) const noexcept -> Pos {
+    assert(Utils::isLegalCap(cap));
+    return key_map_[cap];
+}
+
+inline auto Layout::getHash() const noexcept -> Hash {
+    return hash_;
+}
+
 namespace layout::baselines {
 
     class Baseline : public Layout {
@@ -68,9 +68,10 @@ auto Area::assign(Layout& layout, Prng& prng) noexcept -> void {
  * @brief 随机交换区域内的两个按键.
  * @param layout: 待修改的[键盘布局]对象.
  * @param prng: 符合 C++11 标准的随机数引擎.
+ * @return 被交换的两个键位.
  * @note 假定 layout 合法且与当前区域兼容.
  **/
-auto Area::mutate(Layout& layout, Prng& prng) noexcept -> void {
+auto Area::mutate(Layout& layout, Prng& prng) noexcept -> std::pair<Pos, Pos> {
     // 为了提高效率, 随机抽取两个[键位]的实现其实是: 从打乱的[键位列表]中
     // 依次取出两个[键位], 并在经过一定次数后重新打乱[键位列表]. 因此,
     // idx_ 被初始化为 ths_ + 1, 以便在第一次调用时触发更新.
@@ -83,6 +84,7 @@ auto Area::mutate(Layout& layout, Prng& prng) noexcept -> void {
     const Pos pos1 = pos_list_[idx_++];
     const Pos pos2 = pos_list_[idx_++];
     layout.swap2Keys(pos1, pos2);
+    return {pos1, pos2};
 }
 
 /**
@@ -105,4 +107,18 @@ auto Area::isSafeFor(const Layout& layout) const noexcept -> bool {
     return observed_caps == cap_list_;
 }
 
+/**
+ * @brief 区域内的键值, 升序排列.
+ **/
+auto Area::caps() const noexcept -> std::span<const Cap> {
+    return cap_list_;
+}
+
+/**
+ * @brief 区域内的键位, 顺序不确定.
+ **/
+auto Area::positions() const noexcept -> std::span<const Pos> {
+    return pos_list_;
+}
+
 }
@@ -16,10 +16,13 @@ public:
     Area() = delete;
 
     auto assign(Layout& layout, Prng& prng) noexcept -> void;
-    auto mutate(Layout& layout, Prng& prng) noexcept -> void;
+    auto mutate(Layout& layout, Prng& prng) noexcept -> std::pair<Pos, Pos>;
 
     [[nodiscard]] auto isSafeFor(const Layout& layout) const noexcept -> bool;
 
+    [[nodiscard]] auto caps() const noexcept -> std::span<const Cap>;
+    [[nodiscard]] auto positions() const noexcept -> std::span<const Pos>;
+
 protected:
     std::vector<Cap> cap_list_{}; // 键值列表, 升序排列
     std::vector<Pos> pos_list_{}; // 键位列表, 随机打乱
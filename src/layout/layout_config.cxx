@@ -22,6 +22,17 @@ auto Config::loadCfg(const Toml& cfg) -> void {
     buildLastArea();
 }
 
+/**
+ * @brief 全部可变区域, 包括由未指定的按键构成的最后一个区域.
+ **/
+auto Config::mutableAreas() const noexcept -> const std::vector<Area>& {
+    return mutable_areas_;
+}
+
+auto Config::pinnedKeys() const noexcept -> const std::vector<Key>& {
+    return pinned_keys_;
+}
+
 auto Config::resetCriticalMembers() -> void {
     mutable_areas_.clear();
     pinned_keys_.clear();
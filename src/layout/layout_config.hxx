@@ -17,6 +17,9 @@ public:
 
     auto loadCfg(const Toml& cfg) -> void;
 
+    [[nodiscard]] auto mutableAreas() const noexcept -> const std::vector<Area>&;
+    [[nodiscard]] auto pinnedKeys() const noexcept -> const std::vector<Key>&;
+
 protected:
     std::vector<Area> mutable_areas_{}; // 可变区域列表
     std::vector<Key> pinned_keys_{}; // 固定按键列表
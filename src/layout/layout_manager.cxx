@@ -9,7 +9,7 @@ Manager::Manager()
       need_to_select_area_(cfg_.num_areas_ > 1),
       have_pinned_key_(cfg_.num_pinned_keys_ > 0),
       ths_(cfg_.num_mutable_keys_), idx_(ths_ + 1) {
-    prng_.seed(std::random_device()());
+    prng_.seed(nextSeed());
 }
 
 Manager::Manager(const Manager& other)
@@ -19,7 +19,7 @@ Manager::Manager(const Manager& other)
       need_to_select_area_(other.need_to_select_area_),
       have_pinned_key_(other.have_pinned_key_),
       ths_(other.ths_), idx_(ths_ + 1) {
-    prng_.seed(std::random_device()());
+    prng_.seed(nextSeed());
 }
 
 Manager& Manager::operator=(const Manager& rhs) {
@@ -28,7 +28,7 @@ Manager& Manager::operator=(const Manager& rhs) {
         pinned_keys_ = cfg_.pinned_keys_;
         area_ids_ = cfg_.area_ids_;
 
-        prng_.seed(std::random_device()());
+        prng_.seed(nextSeed());
 
         need_to_select_area_ = rhs.need_to_select_area_;
         have_pinned_key_ = rhs.have_pinned_key_;
@@ -42,6 +42,36 @@ auto Manager::loadCfg(const Toml& cfg) -> void {
     cfg_.loadCfg(cfg);
 }
 
+/**
+ * @brief 设置此后构造的管理器的种子来源, 用于复现实验.
+ * @param seed 基础种子; 为空时恢复以 std::random_device 播种.
+ * @param index 下一个种子的序号, 从检查点恢复时用于接续之前的种子来源.
+ * @note 第 k 个管理器的种子由 (seed, k) 确定; 多线程下各线程取得种子的顺序不固定.
+ **/
+auto Manager::setSeed(const std::optional<uint64_t> seed, const uint64_t index) noexcept -> void {
+    base_seed_ = seed;
+    seed_index_ = index;
+}
+
+/**
+ * @brief 从种子来源中取出下一个种子, 供管理器与其他需要可复现随机数的组件使用.
+ **/
+auto Manager::nextSeed() noexcept -> uint64_t {
+    if (not base_seed_.has_value()) {
+        return std::random_device()();
+    }
+    prng::SplitMix64 mixer(*base_seed_ ^ seed_index_.fetch_add(1) * 0x9E3779B97F4A7C15ull);
+    return mixer();
+}
+
+/**
+ * @brief 种子来源的当前状态, 用于写入检查点.
+ * @return 基础种子, 以及下一个种子的序号.
+ **/
+auto Manager::seedStream() noexcept -> std::pair<std::optional<uint64_t>, uint64_t> {
+    return {base_seed_, seed_index_.load()};
+}
+
 auto Manager::create() noexcept -> Layout {
     Layout layout;
     assignFixedKeys(layout);
@@ -78,16 +108,19 @@ auto Manager::reinit(Layout& layout) noexcept -> void {
  * @brief 使布局产生一个微小的突变.
  * @param child: 待修改的[键盘布局]对象.
  * @param parent: 作为参照的[键盘布局]对象.
+ * @return 被交换的两个键位, 可用于增量地更新代价.
  * @note 假定 parent 合法且与当前设置兼容; 对 child 无要求.
  **/
-auto Manager::mutate(Layout& child, const Layout& parent) noexcept -> void {
+auto Manager::mutate(Layout& child, const Layout& parent) noexcept -> std::pair<Pos, Pos> {
     assert(parent.isValid());
     assert(canManage(parent));
     // 先复制 parent 布局, 再随机突变
     child.key_map_ = parent.key_map_;
+    child.hash_ = parent.hash_;
     // 随机选择一个[可变区域], 交换其中的一对按键
-    randomlySelectAnArea().mutate(child, prng_);
+    const auto swapped = randomlySelectAnArea().mutate(child, prng_);
     assert(child.isValid());
+    return swapped;
 }
 
 auto Manager::randomlySelectAnArea() noexcept -> Area& {
@@ -118,8 +151,11 @@ auto Manager::canManage(const Layout& layout) const noexcept -> bool {
     auto is_compatible = [&layout](const Area& area) -> bool {
         return area.isSafeFor(layout);
     };
-    // 检验是否所有[可变区域]都能兼容 layout.
-    return std::ranges::all_of(mutable_areas_, is_compatible);
+    auto is_pinned = [&layout](const Key& key) -> bool {
+        return layout.getPos(key.cap) == key.pos;
+    };
+    // 检验是否所有[可变区域]都能兼容 layout, 且所有[固定按键]都位于指定的键位.
+    return std::ranges::all_of(mutable_areas_, is_compatible) and std::ranges::all_of(pinned_keys_, is_pinned);
 }
 
 }
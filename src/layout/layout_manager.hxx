@@ -1,6 +1,9 @@
 #ifndef CLUBMOSS_LAYOUT_MANAGER_HXX
 #define CLUBMOSS_LAYOUT_MANAGER_HXX
 
+#include <atomic>
+#include <optional>
+
 #include "layout_config.hxx"
 
 namespace clubmoss::layout {
@@ -13,10 +16,13 @@ public:
     Manager& operator=(const Manager&);
 
     static auto loadCfg(const Toml& cfg) -> void;
+    static auto setSeed(std::optional<uint64_t> seed, uint64_t index = 0) noexcept -> void;
+    static auto nextSeed() noexcept -> uint64_t;
+    [[nodiscard]] static auto seedStream() noexcept -> std::pair<std::optional<uint64_t>, uint64_t>;
 
     auto create() noexcept -> Layout;
     auto reinit(Layout& layout) noexcept -> void;
-    auto mutate(Layout& child, const Layout& parent) noexcept -> void;
+    auto mutate(Layout& child, const Layout& parent) noexcept -> std::pair<Pos, Pos>;
 
     [[nodiscard]] auto canManage(const Layout& layout) const noexcept -> bool;
 
@@ -38,6 +44,9 @@ protected:
 private:
     inline static Config& cfg_ = Config::getInstance();
 
+    inline static std::optional<uint64_t> base_seed_{}; // 为空时以 std::random_device 播种
+    inline static std::atomic<uint64_t> seed_index_{0}; // 已分配的种子数
+
     auto assignFixedKeys(Layout& layout) noexcept -> void;
     auto assignMutableKeys(Layout& layout) noexcept -> void;
 };
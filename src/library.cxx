@@ -1,12 +1,20 @@
 #include <omp.h>
+#include <thread>
 #include "library.hxx"
+#include "module/telemetry/telemetry.hxx"
 
 std::shared_ptr<spdlog::logger> logger;
 
-int search(const int threads) {
+// 同步与异步搜索共用的执行过程
+static int runSearch(
+    const int threads, const clubmoss::optimizer::Control& control,
+    clubmoss::Optimizer::ProgressCallback on_progress
+) {
     try {
         omp_set_num_threads(threads);
         clubmoss::Optimizer o;
+        o.setControl(control);
+        o.setProgressCallback(std::move(on_progress));
         o.search();
     } catch (std::exception& e) {
         spdlog::error("{}", e.what());
@@ -18,6 +26,69 @@ int search(const int threads) {
     return EXIT_SUCCESS;
 }
 
+int search(const int threads) {
+    return runSearch(threads, {}, nullptr);
+}
+
+struct search_handle {
+    std::mutex mutex; // 保护 best_layout 与 best_loss
+    std::string best_layout{};
+    double best_loss{std::numeric_limits<double>::quiet_NaN()};
+
+    std::atomic<bool> finished{false};
+    int status{EXIT_SUCCESS}; // 只在 finished 之后读取
+    std::jthread thread{}; // 最后声明, 以便析构时先请求停止并等待线程结束
+};
+
+search_handle* search_async(
+    const int threads, void (*on_progress)(const char*, double, void*), void* user_data
+) {
+    auto* handle = new search_handle;
+    handle->thread = std::jthread(
+        [handle, threads, on_progress, user_data](const std::stop_token& token) -> void {
+            const auto on_sample = [&](const clubmoss::Sample& sample) -> void {
+                const std::string layout = sample.toString();
+                {
+                    std::lock_guard lock(handle->mutex);
+                    handle->best_layout = layout;
+                    handle->best_loss = sample.getLoss();
+                }
+                if (on_progress) { on_progress(layout.c_str(), sample.getLoss(), user_data); }
+            };
+            handle->status = runSearch(threads, clubmoss::optimizer::Control(token), on_sample);
+            handle->finished.store(true, std::memory_order_release);
+        }
+    );
+    return handle;
+}
+
+int search_poll(search_handle* handle, char* layout, double* loss) {
+    {
+        std::lock_guard lock(handle->mutex);
+        if (layout) {
+            std::ranges::copy(handle->best_layout, layout);
+            layout[handle->best_layout.size()] = '\0';
+        }
+        if (loss) { *loss = handle->best_loss; }
+    }
+    return handle->finished.load(std::memory_order_acquire) ? 0 : 1;
+}
+
+void search_cancel(search_handle* handle) {
+    handle->thread.request_stop();
+}
+
+int search_wait(search_handle* handle) {
+    if (handle->thread.joinable()) {
+        handle->thread.join();
+    }
+    return handle->status;
+}
+
+void search_free(search_handle* handle) {
+    delete handle;
+}
+
 int preprocess(const int threads) {
     try {
         omp_set_num_threads(threads);
@@ -33,6 +104,109 @@ int preprocess(const int threads) {
     return EXIT_SUCCESS;
 }
 
+int compile_corpus(void) {
+    try {
+        clubmoss::metric::Corpus::compile();
+    } catch (std::exception& e) {
+        spdlog::error("{}", e.what());
+        return EXIT_FAILURE;
+    } catch (...) {
+        spdlog::error("Unknown error occurred.");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int extract_ngrams(const char* const* inputs, const int count, const char* output_dir, const int threads) {
+    try {
+        omp_set_num_threads(threads);
+        clubmoss::Extractor e;
+        for (int i = 0; i < count; ++i) {
+            e.ingest(inputs[i]);
+        }
+        e.save(output_dir);
+    } catch (std::exception& e) {
+        spdlog::error("{}", e.what());
+        return EXIT_FAILURE;
+    } catch (...) {
+        spdlog::error("Unknown error occurred.");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int score_layouts(
+    const char* layouts, const int count, double* losses, double* raw_costs, int* flaws, const int threads
+) {
+    using namespace clubmoss;
+    static constexpr uz CHUNK = 64; // 每个任务评估的布局数
+    static std::mutex mutex; // 各线程的工作上下文在多次调用之间复用, 因此调用须串行
+    static optimizer::Workers workers;
+
+    try {
+        std::lock_guard lock(mutex);
+        // 以 num_threads 子句指定线程数, 不改变调用线程的默认线程数
+        const int num_threads = threads > 0 ? threads : omp_get_max_threads();
+        workers.prepare(static_cast<uz>(num_threads));
+
+        const uz n = static_cast<uz>(std::max(count, 0));
+        const uz num_chunks = (n + CHUNK - 1) / CHUNK;
+        std::atomic<bool> all_valid{true};
+
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic) shared(layouts, losses, raw_costs, flaws, workers, n, num_chunks, all_valid) default(none)
+        for (uz c = 0; c < num_chunks; ++c) {
+            optimizer::Worker& worker = workers.local();
+            const uz begin = c * CHUNK;
+            const uz size = std::min(CHUNK, n - begin);
+
+            std::array<uz, CHUNK> index{}; // 合法布局 -> 在本块中的位置
+            worker.layouts.clear();
+            worker.layouts.reserve(CHUNK);
+            for (uz i = 0; i < size; ++i) {
+                try {
+                    worker.layouts.emplace_back(std::string_view(layouts + (begin + i) * KEY_COUNT, KEY_COUNT));
+                    index[worker.layouts.size() - 1] = i;
+                } catch (const FatalError&) {
+                    all_valid = false;
+                }
+            }
+
+            const uz m = worker.layouts.size();
+            std::array<fz, CHUNK> chunk_losses{};
+            std::array<fz, CHUNK * TASK_COUNT> chunk_costs{};
+            std::array<uz, CHUNK> chunk_flaws{};
+            worker.evl.analyzeBatch(
+                worker.layouts, std::span(chunk_losses).first(m),
+                std::span(chunk_costs).first(m * TASK_COUNT), std::span(chunk_flaws).first(m)
+            );
+
+            for (uz i = 0; i < size; ++i) {
+                if (losses) losses[begin + i] = std::numeric_limits<double>::quiet_NaN();
+                if (flaws) flaws[begin + i] = -1;
+                if (raw_costs) std::fill_n(raw_costs + (begin + i) * TASK_COUNT, TASK_COUNT, std::numeric_limits<double>::quiet_NaN());
+            }
+            for (uz k = 0; k < m; ++k) {
+                const uz j = begin + index[k];
+                if (losses) losses[j] = chunk_losses[k];
+                if (flaws) flaws[j] = static_cast<int>(chunk_flaws[k]);
+                if (raw_costs) std::copy_n(chunk_costs.begin() + k * TASK_COUNT, TASK_COUNT, raw_costs + j * TASK_COUNT);
+            }
+        }
+
+        if (not all_valid) {
+            spdlog::error("Some layouts are illegal, their losses are set to NaN.");
+            return EXIT_FAILURE;
+        }
+    } catch (std::exception& e) {
+        spdlog::error("{}", e.what());
+        return EXIT_FAILURE;
+    } catch (...) {
+        spdlog::error("Unknown error occurred.");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
 void set_log_callback(void (*callback)(const char*)) {
     static auto sink = std::make_shared<clubmoss::LogSink>(
         [callback](const std::string& msg) -> void {
@@ -47,3 +221,34 @@ void set_log_callback(void (*callback)(const char*)) {
         logger->sinks().push_back(sink);
     }
 }
+
+void set_telemetry_callback(void (*callback)(const telemetry_report*)) {
+    using namespace clubmoss::telemetry;
+    if (not callback) {
+        Telemetry::setCallback(nullptr);
+        return;
+    }
+    Telemetry::setCallback(
+        [callback](const Report& report) -> void {
+            const auto seconds_of = [&report](const Probe probe) -> double {
+                return static_cast<double>(report.counters.nanos[probe]) * 1e-9;
+            };
+            const uint64_t evaluations = report.counters.evaluations;
+            const telemetry_report c_report{
+                .kind = static_cast<int>(report.kind._value),
+                .pool = report.pool,
+                .epoch = report.epoch,
+                .stagnation_epochs = report.stagnation_epochs,
+                .best_loss = report.best_loss,
+                .seconds = report.seconds,
+                .evaluations = evaluations,
+                .evaluations_per_second = report.seconds > 0.0 ? static_cast<double>(evaluations) / report.seconds : 0.0,
+                .mutate_seconds = seconds_of(Probe::Mutate),
+                .analyze_seconds = seconds_of(Probe::Analyze),
+                .sort_seconds = seconds_of(Probe::Sort),
+                .unique_seconds = seconds_of(Probe::Unique),
+            };
+            callback(&c_report);
+        }
+    );
+}
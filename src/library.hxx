@@ -3,6 +3,7 @@
 
 #include "module/preprocessor/preprocessor.hxx"
 #include "module/optimizer/optimizer.hxx"
+#include "module/extractor/extractor.hxx"
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,10 +19,63 @@ extern "C" {
 
 _export int search(int threads);
 
+// 异步搜索的句柄, 由 search_async() 创建, 必须由 search_free() 释放
+typedef struct search_handle search_handle;
+
+// 在后台线程上开始搜索, 立即返回句柄; on_progress 可以为 NULL, 否则每当找到更优的布局时调用,
+// 各次调用互不重叠, 但可能来自后台线程或其派生的工作线程 (岛屿模式), 回调中不应阻塞过久;
+// layout 为以 '\0' 结尾的 30 字符的布局, 只在回调期间有效
+_export search_handle* search_async(
+    int threads, void (*on_progress)(const char* layout, double loss, void* user_data), void* user_data
+);
+
+// 读取目前为止的最优布局 (layout 至少 31 字节, 可以为 NULL) 与损失 (尚无结果时为 NaN); 仍在运行时返回 1, 否则返回 0
+_export int search_poll(search_handle* handle, char* layout, double* loss);
+
+// 请求停止搜索: 搜索在下一代 (或下一条链, 下一个任务单元) 开始前结束, 并照常保存结果与检查点
+_export void search_cancel(search_handle* handle);
+
+// 等待搜索结束, 返回值与 search() 相同
+_export int search_wait(search_handle* handle);
+
+// 请求停止搜索, 等待其结束并释放句柄
+_export void search_free(search_handle* handle);
+
 _export int preprocess(int threads);
 
+_export int compile_corpus(void);
+
+_export int extract_ngrams(const char* const* inputs, int count, const char* output_dir, int threads);
+
 _export void set_log_callback(void (*callback)(const char*));
 
+// 批量评估布局: layouts 为连续存放的 count 个 30 字符的布局 (不含结尾的 '\0'),
+// 结果写入调用方提供的数组: losses[count], raw_costs[count * 6], flaws[count], 不需要的输出可以传入 NULL.
+// 不合法的布局的损失为 NaN, 缺陷数为 -1; 存在不合法的布局时返回 EXIT_FAILURE.
+// threads 只作用于本次调用, 不大于 0 时使用默认线程数.
+_export int score_layouts(const char* layouts, int count, double* losses, double* raw_costs, int* flaws, int threads);
+
+// 遥测数据: kind 为 0 时是一代的统计, 为 1 时是一个样本池的累计统计; 各项耗时为所有线程之和,
+// evaluations 包括去重与迁入时重新评估的布局. 只有基于样本池的搜索 (样本池, 岛屿与预处理) 发送遥测数据,
+// 退火, 穷举与分支定界不发送
+typedef struct telemetry_report {
+    int kind;
+    uint64_t pool;
+    uint64_t epoch;
+    uint64_t stagnation_epochs;
+    double best_loss;
+    double seconds;
+    uint64_t evaluations;
+    double evaluations_per_second;
+    double mutate_seconds;
+    double analyze_seconds;
+    double sort_seconds;
+    double unique_seconds;
+} telemetry_report;
+
+// 传入 NULL 时关闭遥测
+_export void set_telemetry_callback(void (*callback)(const telemetry_report*));
+
 #ifdef __cplusplus
 }
 #endif
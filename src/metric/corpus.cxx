@@ -0,0 +1,197 @@
+#include "corpus.hxx"
+#include "key_cost/key_cost_data.hxx"
+#include "dis_cost/dis_cost_data.hxx"
+#include "seq_cost/seq_cost_data.hxx"
+
+namespace clubmoss::metric {
+
+using corpus::Record;
+using corpus::Section;
+
+/**
+ * @brief 映射并校验编译后的语料文件.
+ * @param sub_path 语料文件相对于项目根目录的路径.
+ * @return 语料; 如果文件不存在, 已损坏, 或者源文件在编译后发生了变化, 则返回空值.
+ **/
+auto Corpus::open(const std::string_view sub_path) -> std::optional<Corpus> {
+    Corpus corpus;
+    corpus.file_ = MappedFile(Utils::absPath(sub_path));
+    if (not corpus.file_.isOpen()) {
+        return std::nullopt;
+    }
+
+    const std::string_view bytes = corpus.file_.bytes();
+    if (bytes.size() < sizeof(Header)) {
+        spdlog::warn("Ignored truncated corpus \"{:s}\".", sub_path);
+        return std::nullopt;
+    }
+    Header header;
+    std::memcpy(&header, bytes.data(), sizeof(Header));
+    if (header.magic != MAGIC or header.version != VERSION) {
+        spdlog::warn("Ignored incompatible corpus \"{:s}\".", sub_path);
+        return std::nullopt;
+    }
+    if (header.checksum != Utils::fnv1a(bytes.substr(sizeof(Header)))) {
+        spdlog::warn("Ignored corrupted corpus \"{:s}\".", sub_path);
+        return std::nullopt;
+    }
+    if (header.sources != fingerprint()) {
+        spdlog::warn("Ignored outdated corpus \"{:s}\", run compile again to refresh it.", sub_path);
+        return std::nullopt;
+    }
+
+    for (const Language language : Language::_values()) {
+        for (const Section section : Section::_values()) {
+            const uz index = sectionOf(language, section);
+            const auto [offset, count] = header.extents[index];
+            if (offset % alignof(Record) != 0 or offset > bytes.size()
+                or count > (bytes.size() - offset) / sizeof(Record)) {
+                spdlog::warn("Ignored corrupted corpus \"{:s}\".", sub_path);
+                return std::nullopt;
+            }
+            const auto* first = reinterpret_cast<const Record*>(bytes.data() + offset);
+            corpus.sections_[index] = {first, count};
+            if (not std::ranges::all_of(
+                corpus.sections_[index],
+                [section](const Record& record) { return isLegal(record, section); }
+            )) {
+                spdlog::warn("Ignored corrupted corpus \"{:s}\".", sub_path);
+                return std::nullopt;
+            }
+        }
+    }
+    if (std::ranges::any_of(
+        Language::_values(), [&corpus](const Language language) {
+            return corpus.records(language, Section::Chars).size() != KEY_COUNT;
+        }
+    )) {
+        spdlog::warn("Ignored corrupted corpus \"{:s}\".", sub_path);
+        return std::nullopt;
+    }
+    return corpus;
+}
+
+/**
+ * @brief 解析并校验 data/ 目录下的语料文件, 并将其编译为二进制语料.
+ * @param sub_path 输出文件相对于项目根目录的路径.
+ * @throws FatalError 如果语料不合法, 或者无法写入输出文件.
+ **/
+auto Corpus::compile(const std::string_view sub_path) -> void {
+    static auto parse = [](const Language language, const std::string_view file_name) -> Toml {
+        return toml::parse<toml::ordered_type_config>(Utils::absPath(pathOf(language, file_name)));
+    };
+
+    std::array<std::vector<Record>, SECTION_COUNT> sections{};
+    for (const Language language : Language::_values()) {
+        const key_cost::Data kc_data(parse(language, "char.toml"));
+        auto& chars = sections[sectionOf(language, Section::Chars)];
+        for (uz i = 0; i < KEY_COUNT; ++i) {
+            chars.push_back({.freq = kc_data.freq_[i], .caps = {static_cast<uint8_t>(kc_data.caps_[i])}, .size = 1});
+        }
+
+        const dis_cost::Data dc_data(parse(language, "pair.toml"));
+        auto& pairs = sections[sectionOf(language, Section::Pairs)];
+        for (const dis_cost::Op& op : dc_data.records_) {
+            pairs.push_back({
+                .freq = op.f,
+                .caps = {static_cast<uint8_t>(op.src), static_cast<uint8_t>(op.dst)},
+                .size = 2
+            });
+        }
+
+        const seq_cost::Data sc_data(parse(language, "seq.toml"));
+        auto& bigrams = sections[sectionOf(language, Section::Bigrams)];
+        for (const Bigram& bigram : sc_data.bigram_records_) {
+            bigrams.push_back({
+                .freq = bigram.frequencty,
+                .caps = {static_cast<uint8_t>(bigram.caps[0]), static_cast<uint8_t>(bigram.caps[1])},
+                .size = 2
+            });
+        }
+        auto& trigrams = sections[sectionOf(language, Section::Trigrams)];
+        for (const Trigram& trigram : sc_data.trigram_records_) {
+            trigrams.push_back({
+                .freq = trigram.frequencty,
+                .caps = {
+                    static_cast<uint8_t>(trigram.caps[0]),
+                    static_cast<uint8_t>(trigram.caps[1]),
+                    static_cast<uint8_t>(trigram.caps[2])
+                },
+                .size = 3
+            });
+        }
+    }
+
+    Header header;
+    header.sources = fingerprint();
+    std::string payload;
+    for (const auto& [extent, records] : std::views::zip(header.extents, sections)) {
+        extent.offset = sizeof(Header) + payload.size();
+        extent.count = records.size();
+        payload.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+    }
+    header.checksum = Utils::fnv1a(payload);
+
+    const std::string path = Utils::absPath(sub_path);
+    const std::string tmp_path = path + ".tmp";
+    std::ofstream os(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    os.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    os.close();
+    std::error_code ec;
+    if (os.fail()) {
+        std::filesystem::remove(tmp_path, ec);
+        throw FatalError(std::format("Failed to write corpus \"{:s}\"", path));
+    }
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp_path, ec);
+        throw FatalError(std::format("Failed to replace corpus \"{:s}\"", path));
+    }
+    spdlog::info("Compiled corpus to \"{:s}\" ({:d} bytes).", path, sizeof(Header) + payload.size());
+}
+
+/**
+ * @brief 获取某种语言的某类记录.
+ * @return 记录的只读视图, 直接指向映射的内存, 其生命周期与 Corpus 对象相同.
+ **/
+auto Corpus::records(const Language language, const Section section) const -> std::span<const Record> {
+    return sections_[sectionOf(language, section)];
+}
+
+auto Corpus::sectionOf(const Language language, const Section section) noexcept -> uz {
+    return language * Section::_size() + section;
+}
+
+auto Corpus::pathOf(const Language language, const std::string_view file_name) -> std::string {
+    return std::format("data/{:s}/{:s}", Utils::toSnakeCase(language._to_string()), file_name);
+}
+
+/**
+ * @brief 计算全部源文件的指纹, 用于判断编译后的语料是否过期.
+ **/
+auto Corpus::fingerprint() -> Hash {
+    return Utils::fingerprintOf(
+        {
+            "data/chinese/char.toml", "data/chinese/pair.toml", "data/chinese/seq.toml",
+            "data/english/char.toml", "data/english/pair.toml", "data/english/seq.toml",
+        }
+    );
+}
+
+/**
+ * @brief 检查一条记录的键值是否合法. 只有按键对可以包含 ' ', 表示单词的开始或结束.
+ **/
+auto Corpus::isLegal(const Record& record, const Section section) noexcept -> bool {
+    const uz size = section == +Section::Chars ? 1 : section == +Section::Trigrams ? 3 : 2;
+    if (record.size != size) return false;
+    for (uz i = 0; i < size; ++i) {
+        if (not Utils::isLegalCap(record.caps[i])
+            and not (section == +Section::Pairs and record.caps[i] == ' ')) {
+            return false;
+        }
+    }
+    return std::isfinite(record.freq) and record.freq > 0.0;
+}
+
+}
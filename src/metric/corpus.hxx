@@ -0,0 +1,80 @@
+#ifndef CLUBMOSS_CORPUS_HXX
+#define CLUBMOSS_CORPUS_HXX
+
+#include "../common/mapped_file.hxx"
+
+namespace clubmoss::metric {
+
+namespace corpus {
+
+// 二进制语料中的一条记录, 键值已转换为大写 //
+struct Record final {
+    double freq{0.0};
+    std::array<uint8_t, 3> caps{};
+    uint8_t size{0}; // 键值的数量
+    uint32_t reserved{0};
+};
+
+static_assert(sizeof(Record) == 16 and std::is_trivially_copyable_v<Record>);
+
+// @formatter:off //
+BETTER_ENUM(
+    Section, uz,
+    Chars    = 0, // 字符频率
+    Pairs    = 1, // 按键对频率, 已排序并按类型分段
+    Bigrams  = 2, // 2-gram 频率, 已排序
+    Trigrams = 3  // 3-gram 频率, 已排序
+)
+// @formatter:on //
+
+}
+
+// 编译后的二进制语料, 以内存映射的方式加载, 无需解析 TOML 文件 //
+class Corpus {
+public:
+    Corpus(Corpus&&) = default;
+    Corpus& operator=(Corpus&&) = default;
+    Corpus(const Corpus&) = delete;
+    Corpus& operator=(const Corpus&) = delete;
+
+    static auto open(std::string_view sub_path = PATH) -> std::optional<Corpus>;
+    static auto compile(std::string_view sub_path = PATH) -> void;
+
+    [[nodiscard]] auto records(Language language, corpus::Section section) const -> std::span<const corpus::Record>;
+
+    static constexpr auto PATH{"cache/corpus.bin"};
+
+private:
+    static constexpr uz SECTION_COUNT{Language::_size() * corpus::Section::_size()};
+
+    struct Extent final {
+        uint64_t offset{0}; // 相对于文件开头的字节偏移量
+        uint64_t count{0}; // 记录数
+    };
+
+    struct Header final {
+        uint64_t magic{MAGIC};
+        uint32_t version{VERSION};
+        uint32_t reserved{0};
+        Hash sources{0}; // 源文件的指纹
+        Hash checksum{0}; // 全部记录的校验和
+        std::array<Extent, SECTION_COUNT> extents{};
+    };
+
+    static constexpr uint64_t MAGIC{0x50524F43534D4C43}; // "CLMSCORP"
+    static constexpr uint32_t VERSION{1};
+
+    MappedFile file_{};
+    std::array<std::span<const corpus::Record>, SECTION_COUNT> sections_{};
+
+    Corpus() = default;
+
+    static auto sectionOf(Language language, corpus::Section section) noexcept -> uz;
+    static auto pathOf(Language language, std::string_view file_name) -> std::string;
+    static auto fingerprint() -> Hash;
+    static auto isLegal(const corpus::Record& record, corpus::Section section) noexcept -> bool;
+};
+
+}
+
+#endif //CLUBMOSS_CORPUS_HXX
@@ -2,7 +2,9 @@
 
 namespace clubmoss::metric {
 
-DisCost::DisCost(const dis_cost::Data& data) : data_(data) {}
+DisCost::DisCost(const dis_cost::Data& data) : DisCost(std::make_shared<const dis_cost::Data>(data)) {}
+
+DisCost::DisCost(std::shared_ptr<const dis_cost::Data> data) : data_(std::move(data)) {}
 
 /**
  * @brief 计算距离代价
@@ -26,6 +28,62 @@ auto DisCost::analyze(const Layout& layout) -> std::pair<fz, uz> {
     return {cost_, flaw_count_};
 }
 
+/**
+ * @brief 计算距离代价, 检查有效性, 并记录用于增量计算的状态
+ * @param layout 输入的布局
+ * @param state 待更新的状态
+ * @return 距离代价, 缺陷数
+ */
+auto DisCost::analyze(const Layout& layout, State& state) -> std::pair<fz, uz> {
+    calcFingerMovement(layout);
+    state.fingers = finger_move_;
+    state.cost = Utils::sum(state.fingers);
+    state.flaws = countFlaws(state.fingers);
+    return {state.cost, state.flaws};
+}
+
+/**
+ * @brief 在交换两个按键后, 增量地更新距离代价
+ * @param layout 交换按键后的布局
+ * @param pos1 第一个键位
+ * @param pos2 第二个键位
+ * @param state 交换按键前的状态, 将被原地更新
+ * @return 距离代价, 缺陷数
+ */
+auto DisCost::update(const Layout& layout, const Pos pos1, const Pos pos2, State& state) -> std::pair<fz, uz> {
+    const Cap cap1 = layout.getCap(pos1);
+    const Cap cap2 = layout.getCap(pos2);
+
+    // 交换前, cap1 位于 pos2, 而 cap2 位于 pos1
+    auto prev_pos_of = [&layout, cap1, cap2, pos1, pos2](const Cap cap) -> Pos {
+        if (cap == cap1) { return pos2; }
+        if (cap == cap2) { return pos1; }
+        return layout.getPos(cap);
+    };
+    auto curr_pos_of = [&layout](const Cap cap) -> Pos {
+        return layout.getPos(cap);
+    };
+
+    // 对于每条受影响的记录, 先撤销其在交换前的贡献, 再累加其在交换后的贡献
+    auto revise = [&](const dis_cost::Op& op) -> void {
+        accumulate(state.fingers, op, prev_pos_of, -op.f);
+        accumulate(state.fingers, op, curr_pos_of, op.f);
+    };
+    for (const uz i : data_->related_[cap1]) {
+        revise(data_->records_[i]);
+    }
+    for (const uz i : data_->related_[cap2]) {
+        // 同时涉及两个键值的记录已经处理过了
+        if (const auto& op = data_->records_[i]; op.src != cap1 and op.dst != cap1) {
+            revise(op);
+        }
+    }
+
+    state.cost = Utils::sum(state.fingers);
+    state.flaws = countFlaws(state.fingers);
+    return {state.cost, state.flaws};
+}
+
 /**
  * @brief 记录统计数据
  * @param layout 输入的布局
@@ -39,72 +97,71 @@ auto DisCost::scan(const Layout& layout, Toml& stats) -> std::pair<fz, uz> {
     return {cost_, flaw_count_};
 }
 
-auto DisCost::calcFingerMovement(const Layout& layout) noexcept -> void {
-    finger_move_.fill(0.0);
-    for (const auto& op : data_.records_) {
-        const Cap prev_cap = op.src;
-        const Cap next_cap = op.dst;
-        const fz freq = op.f;
-
-        if (prev_cap != ' ' and next_cap != ' ') [[likely]] {
-            updateUsage(layout, prev_cap, next_cap, freq);
-        } else if (prev_cap == ' ') {
-            updateUsage(layout, next_cap, freq);
-        } else if (next_cap == ' ') {
-            updateUsage(layout, prev_cap, freq);
+/**
+ * @brief 将距离代价分解为各按键对的移动距离之和, 以 ' ' 开头或结尾的记录涉及虚拟键位.
+ **/
+auto DisCost::decompose() const -> Decomposition {
+    constexpr uz STRIDE = Decomposition::STRIDE;
+    Decomposition result;
+    result.binary.assign(STRIDE * STRIDE, 0.0);
+    for (Pos prev_pos = 0; prev_pos <= Config::IDLE_POS; ++prev_pos) {
+        for (Pos next_pos = 0; next_pos <= Config::IDLE_POS; ++next_pos) {
+            const Movement& movement = cfg_.movementOf(prev_pos, next_pos);
+            result.binary[prev_pos * STRIDE + next_pos] = movement.distances[0] + movement.distances[1];
         }
     }
+    for (const dis_cost::Op& op : data_->records_) {
+        result.terms.push_back({.caps = {op.src, op.dst, 0}, .size = 2, .freq = op.f});
+    }
+    return result;
 }
 
-auto base_position = [](const uz finger) -> uz {
-    return finger + 10;
-};
-
-auto finger_to_hit = [](const Pos pos) -> uz {
-    const Col col = Utils::colOf(pos);
-    if (col == 4) [[unlikely]] return 3;
-    if (col == 5) [[unlikely]] return 6;
-    return col;
-};
-
-auto DisCost::updateUsage(
-    const Layout& layout,
-    const Cap prev_cap,
-    const Cap next_cap,
-    const fz freq
-) noexcept -> void {
-    const Pos prev_pos = layout.getPos(prev_cap);
-    const Pos next_pos = layout.getPos(next_cap);
-    const uz prev_fin = finger_to_hit(prev_pos);
-    const uz next_fin = finger_to_hit(next_pos);
-
-    // 以 QWERTY 键盘为例
-    if (prev_fin != next_fin) {
-        // C -> V 涉及以下两个动作
-        // 1. 左手中指从 C 到 D
-        // 2. 左手食指从 F 到 V
-        // 需要分别计算这两个动作的距离
-        const Pos prev_fin_curr_pos = base_position(prev_fin);
-        const Pos next_fin_curr_pos = base_position(next_fin);
-        finger_move_[prev_fin] += cfg_.disBetween(prev_fin_curr_pos, prev_pos) * freq;
-        finger_move_[next_fin] += cfg_.disBetween(next_fin_curr_pos, next_pos) * freq;
-    } else {
-        // 而 C -> E 只需计算左手中指的移动距离
-        finger_move_[prev_fin] += cfg_.disBetween(prev_pos, next_pos) * freq;
-    }
+/**
+ * @brief 累加一次手指移动.
+ * @param move 各手指的移动距离.
+ * @param movement 查表得到的手指移动.
+ * @param freq 该移动的频率 (撤销时为负).
+ **/
+auto DisCost::accumulate(Distances& move, const Movement& movement, const fz freq) noexcept -> void {
+    move[movement.fingers[0]] += movement.distances[0] * freq;
+    move[movement.fingers[1]] += movement.distances[1] * freq;
 }
 
-auto DisCost::updateUsage(
-    const Layout& layout,
-    const Cap cap,
+template <typename PosOf>
+auto DisCost::accumulate(
+    Distances& move,
+    const dis_cost::Op& op,
+    const PosOf& pos_of,
     const fz freq
 ) noexcept -> void {
-    // @formatter:off //
-    const Pos pos = layout.getPos(cap);
-    const uz  fin = finger_to_hit(pos);
-    const Pos base_pos = base_position(fin);
-    finger_move_[fin] += cfg_.disBetween(pos, base_pos) * freq;
-    // @formatter:on //
+    // 将 ' ' 映射为虚拟键位, 以便统一查表
+    const Pos prev_pos = op.src == ' ' ? Config::IDLE_POS : pos_of(op.src);
+    const Pos next_pos = op.dst == ' ' ? Config::IDLE_POS : pos_of(op.dst);
+    accumulate(move, cfg_.movementOf(prev_pos, next_pos), freq);
+}
+
+auto DisCost::calcFingerMovement(const Layout& layout) noexcept -> void {
+    finger_move_.fill(0.0);
+
+    const std::span records(data_->records_);
+    const auto pairs = records.first(data_->num_pairs_);
+    const auto starts = records.subspan(data_->num_pairs_, data_->num_starts_);
+    const auto ends = records.subspan(data_->num_pairs_ + data_->num_starts_);
+
+    // 记录已按类型分段, 每一段都只需查表并累加, 无需逐条判断
+    for (const auto& op : pairs) {
+        const Pos prev_pos = layout.getPos(op.src);
+        const Pos next_pos = layout.getPos(op.dst);
+        accumulate(finger_move_, cfg_.movementOf(prev_pos, next_pos), op.f);
+    }
+    for (const auto& op : starts) {
+        const Pos next_pos = layout.getPos(op.dst);
+        accumulate(finger_move_, cfg_.movementOf(Config::IDLE_POS, next_pos), op.f);
+    }
+    for (const auto& op : ends) {
+        const Pos prev_pos = layout.getPos(op.src);
+        accumulate(finger_move_, cfg_.movementOf(prev_pos, Config::IDLE_POS), op.f);
+    }
 }
 
 auto DisCost::calcAndVerifyFingerUsage() noexcept -> void {
@@ -113,24 +170,30 @@ auto DisCost::calcAndVerifyFingerUsage() noexcept -> void {
     for (const Finger fin : Finger::_values()) {
         finger_usage_[fin] = finger_move_[fin] / cost_;
     }
+    flaw_count_ = countFlaws(finger_move_);
+}
+
+auto DisCost::countFlaws(const Distances& move) noexcept -> uz {
+    const fz total = Utils::sum(move);
 
-    flaw_count_ = 0;
+    uz flaw_count = 0;
     // 检查每个手指使用率是否超过限制
     for (const Finger fin : Finger::_values()) {
-        if (finger_usage_[fin] > cfg_.max_finger_mov_[fin]) {
-            ++flaw_count_;
+        if (move[fin] / total > cfg_.max_finger_mov_[fin]) {
+            ++flaw_count;
         }
     }
     // 检查左右手使用是否均衡
     const fz left_hand_usage = std::accumulate(
-        &finger_usage_[Finger::LeftPinky],
-        &finger_usage_[Finger::LeftThumb],
+        &move[Finger::LeftPinky],
+        &move[Finger::LeftThumb],
         0.0
-    );
+    ) / total;
     const fz deviation = std::abs(left_hand_usage - 0.5);
     if (deviation > cfg_.max_hand_mov_imbalance_) {
-        ++flaw_count_;
+        ++flaw_count;
     }
+    return flaw_count;
 }
 
 }
@@ -8,12 +8,17 @@ namespace clubmoss::metric {
 // 距离代价 //
 class DisCost {
 public:
-    explicit DisCost(const dis_cost::Data &data);
+    explicit DisCost(const dis_cost::Data& data);
+    explicit DisCost(std::shared_ptr<const dis_cost::Data> data);
 
     auto measure(const Layout&) -> fz;
     auto analyze(const Layout&) -> std::pair<fz, uz>;
+    auto analyze(const Layout&, State& state) -> std::pair<fz, uz>;
+    auto update(const Layout&, Pos pos1, Pos pos2, State& state) -> std::pair<fz, uz>;
     auto scan(const Layout&, Toml& stats) -> std::pair<fz, uz>;
 
+    [[nodiscard]] auto decompose() const -> Decomposition;
+
     DisCost() = delete;
 
 protected:
@@ -27,13 +32,19 @@ protected:
 
     auto calcAndVerifyFingerUsage() noexcept -> void;
 
-    dis_cost::Data data_;
+    std::shared_ptr<const dis_cost::Data> data_; // 只读的语料数据, 由所有副本共享
 
 private:
     inline static Config& cfg_ = Config::getInstance();
 
-    auto updateUsage(const Layout&, Cap prev_cap, Cap next_cap, fz freq) noexcept -> void;
-    auto updateUsage(const Layout&, Cap cap, fz freq) noexcept -> void;
+    using Distances = std::array<fz, Finger::_size()>;
+
+    static auto accumulate(Distances& move, const Movement& movement, fz freq) noexcept -> void;
+
+    template <typename PosOf>
+    static auto accumulate(Distances& move, const dis_cost::Op& op, const PosOf& pos_of, fz freq) noexcept -> void;
+
+    static auto countFlaws(const Distances& move) noexcept -> uz;
 
     friend class clubmoss::Evaluator;
 };
@@ -12,13 +12,58 @@ Data::Data(const Toml& data) {
             )
         );
     }
-    for (const auto& [i, node] : data.as_table()
-         | std::views::take(MAX_RECORDS)
-         | std::views::enumerate) {
+    for (const auto& [i, node] : data.as_table() | std::views::enumerate) {
         validateRecord(node.first, data, i + 1);
         records_.emplace_back(node);
     }
     std::ranges::sort(records_, std::greater<OrderedPair>());
+    // 只保留频率最高的若干条记录
+    if (records_.size() > MAX_RECORDS) {
+        spdlog::warn(
+            "Only the {:d} most frequent of {:d} records in {:s} are used.",
+            MAX_RECORDS, records_.size(), data.location().file_name()
+        );
+        records_.resize(MAX_RECORDS);
+    }
+    // 按类型将记录分段, 以便在计算时分别处理而无需逐条判断
+    const auto starts = std::ranges::stable_partition(
+        records_, [](const Op& op) -> bool { return op.src != ' ' and op.dst != ' '; }
+    );
+    const auto ends = std::ranges::stable_partition(
+        starts, [](const Op& op) -> bool { return op.src == ' '; }
+    );
+    num_pairs_ = std::distance(records_.begin(), starts.begin());
+    num_starts_ = std::distance(starts.begin(), ends.begin());
+    buildIndex();
+}
+
+/**
+ * @brief 从编译后的语料中加载按键对频率, 记录在编译时已经过校验, 排序与分段.
+ **/
+Data::Data(const Corpus& corpus, const Language language) {
+    for (const corpus::Record& record : corpus.records(language, corpus::Section::Pairs)) {
+        Op& op = records_.emplace_back();
+        op.src = static_cast<Cap>(record.caps[0]);
+        op.dst = static_cast<Cap>(record.caps[1]);
+        op.f = static_cast<fz>(record.freq);
+    }
+    num_pairs_ = std::ranges::count_if(
+        records_, [](const Op& op) -> bool { return op.src != ' ' and op.dst != ' '; }
+    );
+    num_starts_ = std::ranges::count_if(
+        records_, [](const Op& op) -> bool { return op.src == ' '; }
+    );
+    buildIndex();
+}
+
+/**
+ * @brief 建立键值到记录的索引, 以便在交换按键后只更新受影响的记录.
+ **/
+auto Data::buildIndex() -> void {
+    for (const auto& [i, op] : records_ | std::views::enumerate) {
+        if (op.src != ' ') { related_[op.src].emplace_back(i); }
+        if (op.dst != ' ' and op.dst != op.src) { related_[op.dst].emplace_back(i); }
+    }
 }
 
 auto Data::validateRecord(const std::string_view pair, const Toml& data, const uz line) -> void {
@@ -32,6 +77,16 @@ auto Data::validateRecord(const std::string_view pair, const Toml& data, const u
             )
         );
     }
+    // 字段名不能同时以 ' ' 开头和结尾
+    if (pair == "  ") {
+        throw IllegalData(
+            std::format(
+                "illegal field \"{:s}\"\n --> {:s}\n"
+                "line {:d}: expect at least one key code",
+                pair, data.location().file_name(), line
+            )
+        );
+    }
     // 字段名的中字符应当合法
     for (const char c : pair) {
         if (const int cap = std::toupper(c);
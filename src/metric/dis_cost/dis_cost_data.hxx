@@ -2,6 +2,7 @@
 #define CLUBMOSS_DIS_COST_DATA_HXX
 
 #include "../metric_config.hxx"
+#include "../corpus.hxx"
 
 namespace clubmoss::metric::dis_cost {
 
@@ -32,19 +33,29 @@ public:
     Data() = delete;
 
     explicit Data(const Toml& data);
+    Data(const Corpus& corpus, Language language);
 
     static constexpr uz MAX_RECORDS = 250;
 
 protected:
+    // 记录按类型分段存储: 先是普通的按键对, 然后是以 ' ' 开头的记录, 最后是以 ' ' 结尾的记录
     std::vector<Op> records_{};
 
+    uz num_pairs_{0}; // 普通按键对的数量
+    uz num_starts_{0}; // 以 ' ' 开头的记录的数量
+
+    std::array<std::vector<uz>, MAX_KEY_CODE> related_{}; // 键值 -> 涉及该键值的记录的索引
+
 private:
     static auto validateRecord(std::string_view pair, const Toml& data, uz line) -> void;
 
+    auto buildIndex() -> void;
+
     static constexpr char WHAT[]{"Illegal pair-frequency data: {:s}"};
     using IllegalData = IllegalToml<WHAT>;
 
     friend class clubmoss::metric::DisCost;
+    friend class clubmoss::metric::Corpus;
 };
 
 }
@@ -1,8 +1,12 @@
 #include "key_cost.hxx"
+#include "../../common/assignment.hxx"
+#include "../../layout/layout_config.hxx"
 
 namespace clubmoss::metric {
 
-KeyCost::KeyCost(const key_cost::Data& data) : data_(data) {}
+KeyCost::KeyCost(const key_cost::Data& data) : KeyCost(std::make_shared<const key_cost::Data>(data)) {}
+
+KeyCost::KeyCost(std::shared_ptr<const key_cost::Data> data) : data_(std::move(data)) {}
 
 /**
  * @brief 计算击键代价
@@ -12,10 +16,10 @@ KeyCost::KeyCost(const key_cost::Data& data) : data_(data) {}
 auto KeyCost::measure(const Layout& layout) -> fz {
     cost_ = 0.0;
     for (uz i = 0; i < KEY_COUNT; i += 2) {
-        const fz freq1 = data_.freq_[i];
-        const fz freq2 = data_.freq_[i + 1];
-        const Pos pos1 = layout.getPos(data_.caps_[i]);
-        const Pos pos2 = layout.getPos(data_.caps_[i + 1]);
+        const fz freq1 = data_->freq_[i];
+        const fz freq2 = data_->freq_[i + 1];
+        const Pos pos1 = layout.getPos(data_->caps_[i]);
+        const Pos pos2 = layout.getPos(data_->caps_[i + 1]);
         cost_ += cfg_.key_costs_[pos1] * freq1 + cfg_.key_costs_[pos2] * freq2;
     }
     return cost_;
@@ -32,6 +36,45 @@ auto KeyCost::analyze(const Layout& layout) -> std::pair<fz, uz> {
     return {cost_, flaw_count_};
 }
 
+/**
+ * @brief 计算击键代价, 检查有效性, 并记录用于增量计算的状态
+ * @param layout 输入的布局
+ * @param state 待更新的状态
+ * @return 击键代价, 缺陷数
+ */
+auto KeyCost::analyze(const Layout& layout, State& state) -> std::pair<fz, uz> {
+    state.cost = 0.0;
+    state.fingers.fill(0.0);
+    for (uz i = 0; i < KEY_COUNT; ++i) {
+        const fz freq = data_->freq_[i];
+        const Pos pos = layout.getPos(data_->caps_[i]);
+        state.cost += cfg_.key_costs_[pos] * freq;
+        state.fingers[Utils::fingerOf(pos)] += freq;
+    }
+    state.flaws = countFlaws(state.fingers);
+    return {state.cost, state.flaws};
+}
+
+/**
+ * @brief 在交换两个按键后, 增量地更新击键代价
+ * @param layout 交换按键后的布局
+ * @param pos1 第一个键位
+ * @param pos2 第二个键位
+ * @param state 交换按键前的状态, 将被原地更新
+ * @return 击键代价, 缺陷数
+ */
+auto KeyCost::update(const Layout& layout, const Pos pos1, const Pos pos2, State& state) -> std::pair<fz, uz> {
+    // 交换后, pos1 上的键值来自 pos2, 反之亦然, 因此只需转移两者的频率
+    const fz freq1 = data_->freq_of_[layout.getCap(pos1)];
+    const fz freq2 = data_->freq_of_[layout.getCap(pos2)];
+    const fz delta = freq1 - freq2;
+    state.cost += (cfg_.key_costs_[pos1] - cfg_.key_costs_[pos2]) * delta;
+    state.fingers[Utils::fingerOf(pos1)] += delta;
+    state.fingers[Utils::fingerOf(pos2)] -= delta;
+    state.flaws = countFlaws(state.fingers);
+    return {state.cost, state.flaws};
+}
+
 /**
  * @brief 记录统计数据
  * @param layout 输入的布局
@@ -48,6 +91,49 @@ auto KeyCost::scan(const Layout& layout, Toml& stats) -> std::pair<fz, uz> {
     return {cost_, flaw_count_};
 }
 
+/**
+ * @brief 求当前布局设置下击键代价的精确最小值与最大值.
+ * @return 最小代价, 最大代价.
+ * @note 击键代价是按键频率与键位代价的乘积之和, 固定按键的贡献为常数,
+ *       而各个可变区域相互独立, 因此可以分别作为线性指派问题求解.
+ **/
+auto KeyCost::extremes() const -> std::pair<fz, fz> {
+    const layout::Config& layout_cfg = layout::Config::getInstance();
+
+    fz min_cost = 0.0, max_cost = 0.0;
+    for (const Key& key : layout_cfg.pinnedKeys()) {
+        min_cost += cfg_.key_costs_[key.pos] * data_->freq_of_[key.cap];
+        max_cost += cfg_.key_costs_[key.pos] * data_->freq_of_[key.cap];
+    }
+    for (const layout::Area& area : layout_cfg.mutableAreas()) {
+        const std::span<const Cap> caps = area.caps();
+        const std::span<const Pos> positions = area.positions();
+        const uz n = caps.size();
+        std::vector<fz> costs(n * n);
+        for (uz i = 0; i < n; ++i) {
+            for (uz j = 0; j < n; ++j) {
+                costs[i * n + j] = cfg_.key_costs_[positions[j]] * data_->freq_of_[caps[i]];
+            }
+        }
+        min_cost += Assignment::totalOf(costs, n, Assignment::minimize(costs, n));
+        max_cost += Assignment::totalOf(costs, n, Assignment::maximize(costs, n));
+    }
+    return {min_cost, max_cost};
+}
+
+/**
+ * @brief 将击键代价分解为各键值的代价之和.
+ **/
+auto KeyCost::decompose() const -> Decomposition {
+    Decomposition result;
+    result.unary.assign(Decomposition::STRIDE, 0.0);
+    std::ranges::copy(cfg_.key_costs_, result.unary.begin());
+    for (uz i = 0; i < KEY_COUNT; ++i) {
+        result.terms.push_back({.caps = {data_->caps_[i], 0, 0}, .size = 1, .freq = data_->freq_[i]});
+    }
+    return result;
+}
+
 auto is_same_finger = [](const Col col1, const Col col2) -> bool {
     if (col1 == col2) {
         return true;
@@ -73,8 +159,8 @@ auto KeyCost::calcFingerUsage(const Layout& layout) noexcept -> void {
     col_usage_.fill(0.0);
 
     for (uz i = 0; i < KEY_COUNT; ++i) {
-        const fz freq = data_.freq_[i];
-        const Cap cap = data_.caps_[i];
+        const fz freq = data_->freq_[i];
+        const Cap cap = data_->caps_[i];
         const Pos ref_pos = ref.getPos(cap);
         const Pos cur_pos = layout.getPos(cap);
         const Col ref_col = Utils::colOf(ref_pos);
@@ -105,23 +191,28 @@ auto KeyCost::calcFingerUsage(const Layout& layout) noexcept -> void {
 }
 
 auto KeyCost::validateFingerHandUsage() noexcept -> void {
-    flaw_count_ = 0;
+    flaw_count_ = countFlaws(finger_usage_);
+}
+
+auto KeyCost::countFlaws(const std::array<fz, Finger::_size()>& finger_usage) noexcept -> uz {
+    uz flaw_count = 0;
     // 检查每个手指使用率是否超过限制
     for (const Finger fin : Finger::_values()) {
-        if (finger_usage_[fin] > cfg_.max_finger_use_[fin]) {
-            ++flaw_count_;
+        if (finger_usage[fin] > cfg_.max_finger_use_[fin]) {
+            ++flaw_count;
         }
     }
     // 检查左右手使用是否均衡
     const fz left_hand_usage = std::accumulate(
-        &finger_usage_[Finger::LeftPinky],
-        &finger_usage_[Finger::LeftThumb],
+        &finger_usage[Finger::LeftPinky],
+        &finger_usage[Finger::LeftThumb],
         0.0
     );
     const fz deviation = std::abs(left_hand_usage - 0.5);
     if (deviation > cfg_.max_hand_use_imbalance_) {
-        ++flaw_count_;
+        ++flaw_count;
     }
+    return flaw_count;
 }
 
 }
@@ -9,11 +9,18 @@ namespace clubmoss::metric {
 class KeyCost {
 public:
     explicit KeyCost(const key_cost::Data& data);
+    explicit KeyCost(std::shared_ptr<const key_cost::Data> data);
 
     auto measure(const Layout&) -> fz;
     auto analyze(const Layout&) -> std::pair<fz, uz>;
+    auto analyze(const Layout&, State& state) -> std::pair<fz, uz>;
+    auto update(const Layout&, Pos pos1, Pos pos2, State& state) -> std::pair<fz, uz>;
     auto scan(const Layout&, Toml& stats) -> std::pair<fz, uz>;
 
+    [[nodiscard]] auto decompose() const -> Decomposition;
+
+    [[nodiscard]] auto extremes() const -> std::pair<fz, fz>;
+
     KeyCost() = delete;
 
 protected:
@@ -30,13 +37,15 @@ protected:
 
     auto calcFingerUsage(const Layout&) noexcept -> void;
 
-    key_cost::Data data_;
+    std::shared_ptr<const key_cost::Data> data_; // 只读的语料数据, 由所有副本共享
 
 private:
     inline static Config& cfg_ = Config::getInstance();
 
     auto validateFingerHandUsage() noexcept -> void;
 
+    static auto countFlaws(const std::array<fz, Finger::_size()>& finger_usage) noexcept -> uz;
+
     friend class clubmoss::Evaluator;
 };
 
@@ -7,6 +7,7 @@ Data::Data(const Toml& data) {
         validateLine(node.first, data, i + 1);
         caps_[i] = static_cast<Cap>(std::toupper(node.first[0]));
         freq_[i] = static_cast<fz>(node.second.as_floating());
+        freq_of_[caps_[i]] = freq_[i];
     }
     // 所有按键的频率之和应该为 1.0
     if (const fz sum = Utils::sum(freq_);
@@ -34,6 +35,17 @@ Data::Data(const Toml& data) {
     }
 }
 
+/**
+ * @brief 从编译后的语料中加载字符频率, 记录在编译时已经过校验.
+ **/
+Data::Data(const Corpus& corpus, const Language language) {
+    for (const auto& [i, record] : corpus.records(language, corpus::Section::Chars) | std::views::enumerate) {
+        caps_[i] = static_cast<Cap>(record.caps[0]);
+        freq_[i] = static_cast<fz>(record.freq);
+        freq_of_[caps_[i]] = freq_[i];
+    }
+}
+
 auto Data::validateLine(const std::string_view ch, const Toml& data, const uz line) -> void {
     // 字段名的长度应当为 1
     if (ch.size() != 1) {
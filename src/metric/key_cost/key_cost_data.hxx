@@ -2,6 +2,7 @@
 #define CLUBMOSS_KEY_COST_DATA_HXX
 
 #include "../metric_config.hxx"
+#include "../corpus.hxx"
 
 namespace clubmoss::metric::key_cost {
 
@@ -14,16 +15,19 @@ struct Char final {
     Char(const Cap c, const fz f) : cap(c), freq(f) {}
 };
 
-class Data final {
+class alignas(64) Data final {
 public:
     Data() = delete;
 
     explicit Data(const Toml& data);
+    Data(const Corpus& corpus, Language language);
 
 protected:
     std::array<Cap, KEY_COUNT> caps_{};
     std::array<fz, KEY_COUNT> freq_{};
 
+    std::array<fz, MAX_KEY_CODE> freq_of_{}; // 键值 -> 频率
+
 private:
     static auto validateLine(std::string_view ch, const Toml& data, uz line) -> void;
 
@@ -31,6 +35,7 @@ private:
     using IllegalData = IllegalToml<WHAT>;
 
     friend class clubmoss::metric::KeyCost;
+    friend class clubmoss::metric::Corpus;
 };
 
 }
@@ -5,34 +5,44 @@
 
 namespace clubmoss {
 
-struct MetricConcept {
-    virtual ~MetricConcept() = default;
-    virtual auto measure(const Layout&) -> fz = 0;
-    virtual auto analyze(const Layout&) -> std::pair<fz, uz> = 0;
-    virtual auto scan(const Layout&, Toml& stats) -> std::pair<fz, uz> = 0;
-};
-
-template <typename T>
-struct MetricModel final : MetricConcept {
-    explicit MetricModel(T&& t): metric_{std::forward<T>(t)} {}
-    auto measure(const Layout& layout) -> fz override { return metric_.measure(layout); }
-    auto analyze(const Layout& layout) -> std::pair<fz, uz> override { return metric_.analyze(layout); }
-    auto scan(const Layout& layout, Toml& stats) -> std::pair<fz, uz> override { return metric_.scan(layout, stats); }
-
-private:
-    T metric_;
-};
-
-class Metric {
-public:
-    template <typename T> explicit Metric(T&& t): impl_{new MetricModel<T>(std::forward<T>(t))} {}
-    auto measure(const Layout& layout) const -> fz { return impl_->measure(layout); }
-    auto analyze(const Layout& layout) const -> std::pair<fz, uz> { return impl_->analyze(layout); }
-    auto scan(const Layout& layout, Toml& stats) const -> std::pair<fz, uz> { return impl_->scan(layout, stats); }
-
-private:
-    std::unique_ptr<MetricConcept> impl_;
-};
+namespace metric {
+    // 指标的缓存状态, 用于在交换按键后增量地更新代价 //
+    struct State final {
+        fz cost{0.0}; // 代价
+        uz flaws{0}; // 缺陷数
+        std::array<fz, Finger::_size()> fingers{0.0}; // 各手指的使用率或移动距离
+    };
+
+    // 代价分解中的一项, 涉及至多三个键值; ' ' 表示单词的开始或结束, 总是位于虚拟键位 //
+    struct Term final {
+        std::array<Cap, 3> caps{0, 0, 0};
+        u8 size{0}; // 涉及的键值数
+        fz freq{0.0}; // 频率
+    };
+
+    // 指标的代价分解: 代价 = Σ 频率 x 代价表[各键值所在的键位], 用于求代价的下界 //
+    struct Decomposition final {
+        static constexpr uz STRIDE = KEY_CNT_POW2; // 代价表每一维的长度, 包括虚拟键位
+
+        std::vector<Term> terms{};
+        std::vector<fz> unary{}; // [p] -> 代价
+        std::vector<fz> binary{}; // [p][q] -> 代价
+        std::vector<fz> ternary{}; // [p][q][r] -> 代价
+
+        /**
+         * @brief 查表求一项的代价.
+         * @param term 待求的项.
+         * @param pos 各键值所在的键位, 只使用前 term.size 个.
+         **/
+        [[nodiscard]] auto costOf(const Term& term, const std::array<Pos, 3>& pos) const noexcept -> fz {
+            switch (term.size) {
+            case 1: return unary[pos[0]];
+            case 2: return binary[pos[0] * STRIDE + pos[1]];
+            default: return ternary[(pos[0] * STRIDE + pos[1]) * STRIDE + pos[2]];
+            }
+        }
+    };
+}
 
 namespace metric {
     class KeyCost;
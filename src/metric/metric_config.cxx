@@ -5,6 +5,7 @@ namespace clubmoss::metric {
 Config::Config() {
     calcNgramCosts();
     calcDistance();
+    calcMovements();
 }
 
 auto Config::getInstance() -> Config& {
@@ -20,12 +21,31 @@ auto Config::disBetween(const Pos pos1, const Pos pos2) const -> fz {
     return distance_map_[index(pos1, pos2)];
 }
 
+/**
+ * @brief 查询连续两次击键所引起的手指移动.
+ * @param prev_pos 前一次击键的键位, 为 IDLE_POS 时表示序列的开始.
+ * @param next_pos 后一次击键的键位, 为 IDLE_POS 时表示序列的结束.
+ **/
+auto Config::movementOf(const Pos prev_pos, const Pos next_pos) const -> const Movement& {
+    return movements_[index(prev_pos, next_pos)];
+}
+
+auto Config::costOf(const Pos pos1, const Pos pos2) const -> uz {
+    return ngram_costs_[index(pos1, pos2)];
+}
+
+auto Config::costOf(const Pos pos1, const Pos pos2, const Pos pos3) const -> uz {
+    const uz lvl1 = ngram_costs_[index(pos1, pos2)];
+    const uz lvl2 = ngram_costs_[index(pos2, pos3)];
+    return std::max(lvl1, lvl2);
+}
+
 auto Config::costOf(const Bigram& bigram, const Layout& layout) const -> uz {
     const Cap cap1 = bigram.caps[0];
     const Cap cap2 = bigram.caps[1];
     const Pos pos1 = layout.getPos(cap1);
     const Pos pos2 = layout.getPos(cap2);
-    return ngram_costs_[index(pos1, pos2)];
+    return costOf(pos1, pos2);
 }
 
 auto Config::costOf(const Trigram& trigram, const Layout& layout) const -> uz {
@@ -35,9 +55,7 @@ auto Config::costOf(const Trigram& trigram, const Layout& layout) const -> uz {
     const Pos pos1 = layout.getPos(cap1);
     const Pos pos2 = layout.getPos(cap2);
     const Pos pos3 = layout.getPos(cap3);
-    const uz lvl1 = ngram_costs_[index(pos1, pos2)];
-    const uz lvl2 = ngram_costs_[index(pos2, pos3)];
-    return std::max(lvl1, lvl2);
+    return costOf(pos1, pos2, pos3);
 }
 
 auto Config::painLevelOf(const Bigram& bigram, const Layout& layout) const -> uz {
@@ -69,6 +87,7 @@ auto Config::loadCfg(const Toml& metric_cfg, const Toml& score_cfg) -> void {
     instance.loadSeqCostCfgs(metric_cfg.at("seq_cost"));
     instance.calcNgramCosts();
     instance.calcDistance();
+    instance.calcMovements();
 }
 
 auto Config::loadFingerHandLimits(const Toml& cfg) -> void {
@@ -168,6 +187,47 @@ auto Config::calcDistance() -> void {
     }
 }
 
+auto base_position = [](const uz finger) -> Pos {
+    return static_cast<Pos>(finger + 10);
+};
+
+auto Config::calcMovements() -> void {
+    movements_.fill(Movement{});
+    for (const Pos prev_pos : POS_SET) {
+        for (const Pos next_pos : POS_SET) {
+            const auto prev_fin = static_cast<u8>(Utils::fingerOf(prev_pos));
+            const auto next_fin = static_cast<u8>(Utils::fingerOf(next_pos));
+            Movement& movement = movements_[index(prev_pos, next_pos)];
+            // 以 QWERTY 键盘为例
+            if (prev_fin != next_fin) {
+                // C -> V 涉及以下两个动作
+                // 1. 左手中指从 C 到 D
+                // 2. 左手食指从 F 到 V
+                // 需要分别计算这两个动作的距离
+                movement.fingers = {prev_fin, next_fin};
+                movement.distances = {
+                    disBetween(base_position(prev_fin), prev_pos),
+                    disBetween(base_position(next_fin), next_pos),
+                };
+            } else {
+                // 而 C -> E 只需计算左手中指的移动距离
+                movement.fingers = {prev_fin, prev_fin};
+                movement.distances = {disBetween(prev_pos, next_pos), 0.0};
+            }
+        }
+    }
+    // 序列的开始和结束: 手指在基准键位与目标键位之间移动
+    for (const Pos pos : POS_SET) {
+        const auto fin = static_cast<u8>(Utils::fingerOf(pos));
+        const Movement movement{
+            .fingers = {fin, fin},
+            .distances = {disBetween(pos, base_position(fin)), 0.0},
+        };
+        movements_[index(IDLE_POS, pos)] = movement;
+        movements_[index(pos, IDLE_POS)] = movement;
+    }
+}
+
 auto Config::checkArraySize(const Toml& node, const std::string_view msg, const size_t expected_size) -> void {
     if (node.size() != expected_size) {
         throw IllegalCfg(
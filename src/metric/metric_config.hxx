@@ -29,6 +29,12 @@ struct Ngram final {
 using Bigram = Ngram<2>;
 using Trigram = Ngram<3>;
 
+// 连续两次击键所引起的手指移动, 至多涉及两个手指 //
+struct Movement final {
+    std::array<u8, 2> fingers{0, 0}; // 移动的手指
+    std::array<fz, 2> distances{0.0, 0.0}; // 相应的移动距离
+};
+
 class Config {
     static constexpr uz FIN_COUNT = Finger::_size();
     static constexpr uz LVL_COUNT = PainLevel::_size();
@@ -42,7 +48,12 @@ public:
 
     static auto getInstance() -> Config&;
 
+    static constexpr Pos IDLE_POS = KEY_COUNT; // 虚拟键位, 表示击键序列的开始或结束
+
     auto disBetween(Pos pos1, Pos pos2) const -> fz;
+    auto movementOf(Pos prev_pos, Pos next_pos) const -> const Movement&;
+    auto costOf(Pos pos1, Pos pos2) const -> uz;
+    auto costOf(Pos pos1, Pos pos2, Pos pos3) const -> uz;
     auto costOf(const Bigram& bigram, const Layout& layout) const -> uz;
     auto costOf(const Trigram& trigram, const Layout& layout) const -> uz;
     auto painLevelOf(const Bigram& bigram, const Layout& layout) const -> uz;
@@ -53,6 +64,8 @@ public:
 protected:
     std::array<fz, KEY_CNT_POW2 * KEY_CNT_POW2> distance_map_{0.0};
 
+    std::array<Movement, KEY_CNT_POW2 * KEY_CNT_POW2> movements_{};
+
     std::array<uz, KEY_CNT_POW2 * KEY_CNT_POW2> ngram_costs_{0};
 
     std::array<fz, KEY_COUNT> key_costs_{
@@ -76,6 +89,7 @@ protected:
 
     auto calcNgramCosts() -> void;
     auto calcDistance() -> void;
+    auto calcMovements() -> void;
 
     Config();
 
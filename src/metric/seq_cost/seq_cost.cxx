@@ -2,7 +2,9 @@
 
 namespace clubmoss::metric {
 
-SeqCost::SeqCost(const seq_cost::Data& data) : data_(data) {}
+SeqCost::SeqCost(const seq_cost::Data& data) : SeqCost(std::make_shared<const seq_cost::Data>(data)) {}
+
+SeqCost::SeqCost(std::shared_ptr<const seq_cost::Data> data) : data_(std::move(data)) {}
 
 /**
  * @brief 计算组合代价
@@ -10,11 +12,15 @@ SeqCost::SeqCost(const seq_cost::Data& data) : data_(data) {}
  * @return 组合代价
 */
 auto SeqCost::measure(const Layout& layout) -> fz {
+    if (data_->isDense()) {
+        syncCosts(positionsOf(layout));
+        return cost_ = denseCost(curr_costs_.data());
+    }
     cost_ = 0.0;
-    for (const Bigram& bigram : data_.bigram_records_) {
+    for (const Bigram& bigram : data_->bigram_records_) {
         cost_ += static_cast<fz>(cfg_.costOf(bigram, layout)) * bigram.frequencty;
     }
-    for (const Trigram& trigram : data_.trigram_records_) {
+    for (const Trigram& trigram : data_->trigram_records_) {
         cost_ += static_cast<fz>(cfg_.costOf(trigram, layout)) * trigram.frequencty;
     }
     return cost_;
@@ -26,29 +32,127 @@ auto SeqCost::measure(const Layout& layout) -> fz {
  * @return 组合代价
 */
 auto SeqCost::analyze(const Layout& layout) -> std::pair<fz, uz> {
+    if (data_->isDense()) {
+        syncCosts(positionsOf(layout));
+        cost_ = denseCost(curr_costs_.data());
+        flaw_count_ = countFlaws(layout);
+        return {cost_, flaw_count_};
+    }
     cost_ = 0.0;
     flaw_count_ = 0;
     // 考察 2-gram 记录
-    for (const auto& bigram : data_.bigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
+    for (const auto& bigram : data_->bigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
         const uz cost = cfg_.costOf(bigram, layout);
         cost_ += static_cast<fz>(cost) * bigram.frequencty;
         if (cost > cfg_.max_ngram_cost_) { ++flaw_count_; }
     }
-    for (const auto& bigram : data_.bigram_records_ | std::views::drop(cfg_.ngrams_to_test_)) {
+    for (const auto& bigram : data_->bigram_records_ | std::views::drop(cfg_.ngrams_to_test_)) {
         cost_ += static_cast<fz>(cfg_.costOf(bigram, layout)) * bigram.frequencty;
     }
     // 考察 3-gram 记录
-    for (const auto& trigram : data_.trigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
+    for (const auto& trigram : data_->trigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
         const uz cost = cfg_.costOf(trigram, layout);
         cost_ += static_cast<fz>(cost) * trigram.frequencty;
         if (cost > cfg_.max_ngram_cost_) { ++flaw_count_; }
     }
-    for (const auto& trigram : data_.trigram_records_ | std::views::drop(cfg_.ngrams_to_test_)) {
+    for (const auto& trigram : data_->trigram_records_ | std::views::drop(cfg_.ngrams_to_test_)) {
         cost_ += static_cast<fz>(cfg_.costOf(trigram, layout)) * trigram.frequencty;
     }
     return {cost_, flaw_count_};
 }
 
+/**
+ * @brief 计算组合代价, 检查有效性, 并记录用于增量计算的状态
+ * @param layout 输入的布局
+ * @param state 待更新的状态
+ * @return 组合代价, 缺陷数
+ */
+auto SeqCost::analyze(const Layout& layout, State& state) -> std::pair<fz, uz> {
+    std::tie(state.cost, state.flaws) = analyze(layout);
+    return {state.cost, state.flaws};
+}
+
+/**
+ * @brief 在交换两个按键后, 增量地更新组合代价
+ * @param layout 交换按键后的布局
+ * @param pos1 第一个键位
+ * @param pos2 第二个键位
+ * @param state 交换按键前的状态, 将被原地更新
+ * @return 组合代价, 缺陷数
+ */
+auto SeqCost::update(const Layout& layout, const Pos pos1, const Pos pos2, State& state) -> std::pair<fz, uz> {
+    const Cap cap1 = layout.getCap(pos1);
+    const Cap cap2 = layout.getCap(pos2);
+    const bool dense = data_->isDense();
+
+    // 稠密表示: 只重新计算涉及 cap1 或 cap2 的项
+    if (dense) {
+        const uz id1 = seq_cost::Data::ID_OF[cap1];
+        const uz id2 = seq_cost::Data::ID_OF[cap2];
+        std::array<Pos, KEY_COUNT> pos_of = positionsOf(layout);
+        syncCosts(pos_of);
+        const fz curr_cost = denseCostAround(id1, id2, curr_costs_.data());
+        // 原地改写两个键值所在的行与列, 得到交换前的代价矩阵, 求和后再改写回来
+        std::swap(pos_of[id1], pos_of[id2]);
+        patchCosts(pos_of, id1, curr_costs_);
+        patchCosts(pos_of, id2, curr_costs_);
+        const fz prev_cost = denseCostAround(id1, id2, curr_costs_.data());
+        std::swap(pos_of[id1], pos_of[id2]);
+        patchCosts(pos_of, id1, curr_costs_);
+        patchCosts(pos_of, id2, curr_costs_);
+        state.cost += curr_cost - prev_cost;
+    }
+
+    // 交换前, cap1 位于 pos2, 而 cap2 位于 pos1
+    auto prev_pos_of = [&layout, cap1, cap2, pos1, pos2](const Cap cap) -> Pos {
+        if (cap == cap1) { return pos2; }
+        if (cap == cap2) { return pos1; }
+        return layout.getPos(cap);
+    };
+    auto curr_pos_of = [&layout](const Cap cap) -> Pos {
+        return layout.getPos(cap);
+    };
+    auto cost_of = [](const auto& ngram, const auto& pos_of) -> uz {
+        if constexpr (std::same_as<std::remove_cvref_t<decltype(ngram)>, Bigram>) {
+            return cfg_.costOf(pos_of(ngram.caps[0]), pos_of(ngram.caps[1]));
+        } else {
+            return cfg_.costOf(pos_of(ngram.caps[0]), pos_of(ngram.caps[1]), pos_of(ngram.caps[2]));
+        }
+    };
+
+    // 对于每条受影响的记录, 用交换后的代价替换交换前的代价, 并同步更新缺陷数
+    auto revise = [&](const auto& ngram, const uz rank) -> void {
+        const uz prev_cost = cost_of(ngram, prev_pos_of);
+        const uz curr_cost = cost_of(ngram, curr_pos_of);
+        if (not dense) {
+            state.cost += (static_cast<fz>(curr_cost) - static_cast<fz>(prev_cost)) * ngram.frequencty;
+        }
+        if (rank < cfg_.ngrams_to_test_) {
+            if (curr_cost > cfg_.max_ngram_cost_) { ++state.flaws; }
+            if (prev_cost > cfg_.max_ngram_cost_) { --state.flaws; }
+        }
+    };
+    // 稠密表示下代价已经更新, 只需检查最常用的记录, 而索引按排名升序排列, 可以提前结束
+    const uz limit = dense ? cfg_.ngrams_to_test_ : std::numeric_limits<uz>::max();
+    auto revise_all = [&](const auto& records, const auto& related) -> void {
+        for (const uz i : related[cap1]) {
+            if (i >= limit) break;
+            revise(records[i], i);
+        }
+        for (const uz i : related[cap2]) {
+            if (i >= limit) break;
+            // 同时涉及两个键值的记录已经处理过了
+            if (const auto& caps = records[i].caps; std::ranges::find(caps, cap1) == caps.end()) {
+                revise(records[i], i);
+            }
+        }
+    };
+    revise_all(data_->bigram_records_, data_->related_bigrams_);
+    revise_all(data_->trigram_records_, data_->related_trigrams_);
+
+    return {state.cost, state.flaws};
+}
+
 /**
  * @brief 记录统计数据
  * @param layout 输入的布局
@@ -60,26 +164,40 @@ auto SeqCost::scan(const Layout& layout, Toml& stats) -> std::pair<fz, uz> {
     flaw_count_ = 0;
     pain_level_of_top_2_grams_.clear();
     pain_level_of_top_3_grams_.clear();
+    if (data_->isDense()) {
+        for (const auto& bigram : data_->bigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
+            pain_level_of_top_2_grams_.emplace_back(cfg_.painLevelOf(bigram, layout));
+        }
+        for (const auto& trigram : data_->trigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
+            pain_level_of_top_3_grams_.emplace_back(cfg_.painLevelOf(trigram, layout));
+        }
+        syncCosts(positionsOf(layout));
+        cost_ = denseCost(curr_costs_.data());
+        flaw_count_ = countFlaws(layout);
+        stats.at("2_gram_pain_levels") = pain_level_of_top_2_grams_;
+        stats.at("3_gram_pain_levels") = pain_level_of_top_3_grams_;
+        return {cost_, flaw_count_};
+    }
     // 考察 2-gram 记录
-    for (const auto& bigram : data_.bigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
+    for (const auto& bigram : data_->bigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
         const uz cost = cfg_.costOf(bigram, layout);
         cost_ += static_cast<fz>(cost) * bigram.frequencty;
         if (cost > cfg_.max_ngram_cost_) { ++flaw_count_; }
         const uz pain = cfg_.painLevelOf(bigram, layout);
         pain_level_of_top_2_grams_.emplace_back(pain);
     }
-    for (const auto& bigram : data_.bigram_records_ | std::views::drop(cfg_.ngrams_to_test_)) {
+    for (const auto& bigram : data_->bigram_records_ | std::views::drop(cfg_.ngrams_to_test_)) {
         cost_ += static_cast<fz>(cfg_.costOf(bigram, layout)) * bigram.frequencty;
     }
     // 考察 3-gram 记录
-    for (const auto& trigram : data_.trigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
+    for (const auto& trigram : data_->trigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
         const uz cost = cfg_.costOf(trigram, layout);
         cost_ += static_cast<fz>(cost) * trigram.frequencty;
         if (cost > cfg_.max_ngram_cost_) { ++flaw_count_; }
         const uz pain = cfg_.painLevelOf(trigram, layout);
         pain_level_of_top_3_grams_.emplace_back(pain);
     }
-    for (const auto& trigram : data_.trigram_records_ | std::views::drop(cfg_.ngrams_to_test_)) {
+    for (const auto& trigram : data_->trigram_records_ | std::views::drop(cfg_.ngrams_to_test_)) {
         cost_ += static_cast<fz>(cfg_.costOf(trigram, layout)) * trigram.frequencty;
     }
 
@@ -89,4 +207,194 @@ auto SeqCost::scan(const Layout& layout, Toml& stats) -> std::pair<fz, uz> {
     return {cost_, flaw_count_};
 }
 
+/**
+ * @brief 将组合代价分解为各 n-gram 的代价之和.
+ **/
+auto SeqCost::decompose() const -> Decomposition {
+    constexpr uz STRIDE = Decomposition::STRIDE;
+    Decomposition result;
+    result.binary.assign(STRIDE * STRIDE, 0.0);
+    result.ternary.assign(STRIDE * STRIDE * STRIDE, 0.0);
+    for (Pos p = 0; p < KEY_COUNT; ++p) {
+        for (Pos q = 0; q < KEY_COUNT; ++q) {
+            result.binary[p * STRIDE + q] = static_cast<fz>(cfg_.costOf(p, q));
+            for (Pos r = 0; r < KEY_COUNT; ++r) {
+                result.ternary[(p * STRIDE + q) * STRIDE + r] = static_cast<fz>(cfg_.costOf(p, q, r));
+            }
+        }
+    }
+    for (const Bigram& bigram : data_->bigram_records_) {
+        result.terms.push_back({.caps = {bigram.caps[0], bigram.caps[1], 0}, .size = 2, .freq = bigram.frequencty});
+    }
+    for (const Trigram& trigram : data_->trigram_records_) {
+        result.terms.push_back({.caps = trigram.caps, .size = 3, .freq = trigram.frequencty});
+    }
+    return result;
+}
+
+/**
+ * @brief 各键值 (按稠密编号) 所在的键位.
+ **/
+auto SeqCost::positionsOf(const Layout& layout) noexcept -> std::array<Pos, KEY_COUNT> {
+    std::array<Pos, KEY_COUNT> pos_of{};
+    for (uz id = 0; id < KEY_COUNT; ++id) {
+        pos_of[id] = layout.getPos(CAP_SET[id]);
+    }
+    return pos_of;
+}
+
+/**
+ * @brief 将按键位索引的 2-gram 代价重排为按稠密编号索引的代价矩阵, 补齐的部分为 0.
+ **/
+auto SeqCost::fillCosts(const std::array<Pos, KEY_COUNT>& pos_of, const std::span<fz> costs) noexcept -> void {
+    for (uz a = 0; a < KEY_COUNT; ++a) {
+        for (uz b = 0; b < KEY_COUNT; ++b) {
+            costs[a * KEY_CNT_POW2 + b] = static_cast<fz>(cfg_.costOf(pos_of[a], pos_of[b]));
+        }
+    }
+}
+
+/**
+ * @brief 改写代价矩阵中 id 所在的行与列.
+ **/
+auto SeqCost::patchCosts(const std::array<Pos, KEY_COUNT>& pos_of, const uz id, const std::span<fz> costs) noexcept -> void {
+    for (uz x = 0; x < KEY_COUNT; ++x) {
+        costs[id * KEY_CNT_POW2 + x] = static_cast<fz>(cfg_.costOf(pos_of[id], pos_of[x]));
+        costs[x * KEY_CNT_POW2 + id] = static_cast<fz>(cfg_.costOf(pos_of[x], pos_of[id]));
+    }
+}
+
+/**
+ * @brief 使代价矩阵与给定的布局一致: 只改写移动过的键值所在的行与列, 移动的键值过多时重新填充.
+ * @note 退火与枚举中相继评估的布局只相差一次交换, 因此通常只需改写两行两列.
+ **/
+auto SeqCost::syncCosts(const std::array<Pos, KEY_COUNT>& pos_of) noexcept -> void {
+    std::array<uz, KEY_COUNT> moved{};
+    uz count = 0;
+    for (uz id = 0; id < KEY_COUNT; ++id) {
+        if (pos_of[id] != costs_pos_of_[id]) { moved[count++] = id; }
+    }
+    if (not costs_valid_ or count > MAX_PATCHED_KEYS) {
+        fillCosts(pos_of, curr_costs_);
+    } else {
+        for (const uz id : moved | std::views::take(count)) {
+            patchCosts(pos_of, id, curr_costs_);
+        }
+    }
+    costs_pos_of_ = pos_of;
+    costs_valid_ = true;
+}
+
+/**
+ * @brief 计算以 (a, b) 开头的所有 3-gram 的代价之和.
+ * @param freqs 频率张量中 (a, b) 所在的行.
+ * @param cost_ab 依次敲击 a, b 的代价.
+ * @param costs_b 代价矩阵中 b 所在的行.
+ **/
+auto SeqCost::trigramRow(const fz* freqs, const fz cost_ab, const fz* costs_b) noexcept -> fz {
+    fz sum = 0.0;
+    #pragma omp simd reduction(+:sum)
+    for (uz c = 0; c < KEY_CNT_POW2; ++c) {
+        sum += freqs[c] * std::max(cost_ab, costs_b[c]);
+    }
+    return sum;
+}
+
+/**
+ * @brief 在稠密表示下计算组合代价, 覆盖全部记录.
+ * @param costs 代价矩阵.
+ * @note 代价矩阵只有数 KB, 始终驻留在 L1 缓存中, 频率张量则按行顺序流式读取.
+ **/
+auto SeqCost::denseCost(const fz* costs) const noexcept -> fz {
+    const fz* bigrams = data_->bigram_tensor_.data();
+    const fz* trigrams = data_->trigram_tensor_.data();
+
+    fz sum = 0.0;
+    #pragma omp simd reduction(+:sum)
+    for (uz i = 0; i < seq_cost::Data::BIGRAM_TENSOR_SIZE; ++i) {
+        sum += bigrams[i] * costs[i];
+    }
+    for (uz a = 0; a < KEY_COUNT; ++a) {
+        for (uz b = 0; b < KEY_COUNT; ++b) {
+            const fz* row = trigrams + (a * KEY_COUNT + b) * KEY_CNT_POW2;
+            sum += trigramRow(row, costs[a * KEY_CNT_POW2 + b], costs + b * KEY_CNT_POW2);
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief 在稠密表示下计算所有涉及 id1 或 id2 的项之和, 用于增量计算.
+ * @param id1 第一个键值的稠密编号.
+ * @param id2 第二个键值的稠密编号.
+ * @param costs 代价矩阵.
+ * @note 按第二个字符, 第一个字符, 第三个字符依次划分, 每一项恰好计入一次.
+ **/
+auto SeqCost::denseCostAround(const uz id1, const uz id2, const fz* costs) const noexcept -> fz {
+    const fz* bigrams = data_->bigram_tensor_.data();
+    const fz* trigrams = data_->trigram_tensor_.data();
+    const std::array ids{id1, id2};
+    const uz count = id1 == id2 ? 1 : 2;
+    auto involved = [id1, id2](const uz id) -> bool { return id == id1 or id == id2; };
+
+    fz sum = 0.0;
+    // 2-gram: 以 id 开头的行, 以及以 id 结尾的列
+    for (const uz x : ids | std::views::take(count)) {
+        const fz* freqs = bigrams + x * KEY_CNT_POW2;
+        const fz* row = costs + x * KEY_CNT_POW2;
+        #pragma omp simd reduction(+:sum)
+        for (uz b = 0; b < KEY_CNT_POW2; ++b) {
+            sum += freqs[b] * row[b];
+        }
+    }
+    for (uz a = 0; a < KEY_COUNT; ++a) {
+        if (involved(a)) continue;
+        for (const uz x : ids | std::views::take(count)) {
+            sum += bigrams[a * KEY_CNT_POW2 + x] * costs[a * KEY_CNT_POW2 + x];
+        }
+    }
+    // 3-gram: 第二个字符为 id
+    for (const uz b : ids | std::views::take(count)) {
+        for (uz a = 0; a < KEY_COUNT; ++a) {
+            const fz* row = trigrams + (a * KEY_COUNT + b) * KEY_CNT_POW2;
+            sum += trigramRow(row, costs[a * KEY_CNT_POW2 + b], costs + b * KEY_CNT_POW2);
+        }
+    }
+    // 3-gram: 第一个字符为 id, 第二个字符不是
+    for (const uz a : ids | std::views::take(count)) {
+        for (uz b = 0; b < KEY_COUNT; ++b) {
+            if (involved(b)) continue;
+            const fz* row = trigrams + (a * KEY_COUNT + b) * KEY_CNT_POW2;
+            sum += trigramRow(row, costs[a * KEY_CNT_POW2 + b], costs + b * KEY_CNT_POW2);
+        }
+    }
+    // 3-gram: 只有第三个字符为 id
+    for (uz a = 0; a < KEY_COUNT; ++a) {
+        if (involved(a)) continue;
+        for (uz b = 0; b < KEY_COUNT; ++b) {
+            if (involved(b)) continue;
+            const fz* row = trigrams + (a * KEY_COUNT + b) * KEY_CNT_POW2;
+            const fz cost_ab = costs[a * KEY_CNT_POW2 + b];
+            for (const uz c : ids | std::views::take(count)) {
+                sum += row[c] * std::max(cost_ab, costs[b * KEY_CNT_POW2 + c]);
+            }
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief 统计最常用的 n-gram 中代价过高的数量.
+ **/
+auto SeqCost::countFlaws(const Layout& layout) const noexcept -> uz {
+    uz flaws = 0;
+    for (const auto& bigram : data_->bigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
+        if (cfg_.costOf(bigram, layout) > cfg_.max_ngram_cost_) { ++flaws; }
+    }
+    for (const auto& trigram : data_->trigram_records_ | std::views::take(cfg_.ngrams_to_test_)) {
+        if (cfg_.costOf(trigram, layout) > cfg_.max_ngram_cost_) { ++flaws; }
+    }
+    return flaws;
+}
+
 }
@@ -9,11 +9,16 @@ namespace clubmoss::metric {
 class SeqCost {
 public:
     explicit SeqCost(const seq_cost::Data& data);
+    explicit SeqCost(std::shared_ptr<const seq_cost::Data> data);
 
     auto measure(const Layout&) -> fz;
     auto analyze(const Layout&) -> std::pair<fz, uz>;
+    auto analyze(const Layout&, State& state) -> std::pair<fz, uz>;
+    auto update(const Layout&, Pos pos1, Pos pos2, State& state) -> std::pair<fz, uz>;
     auto scan(const Layout&, Toml& stats) -> std::pair<fz, uz>;
 
+    [[nodiscard]] auto decompose() const -> Decomposition;
+
     SeqCost() = delete;
 
 protected:
@@ -23,11 +28,28 @@ protected:
     std::vector<uz> pain_level_of_top_2_grams_{}; // 最常用的 2-gram 的不适程度
     std::vector<uz> pain_level_of_top_3_grams_{}; // 最常用的 3-gram 的不适程度
 
-    seq_cost::Data data_;
+    std::shared_ptr<const seq_cost::Data> data_; // 只读的语料数据, 由所有副本共享
+
+    // 稠密表示下的代价矩阵, [a][b] -> 依次敲击 a, b 的代价
+    alignas(64) std::array<fz, seq_cost::Data::BIGRAM_TENSOR_SIZE> curr_costs_{};
+    std::array<Pos, KEY_COUNT> costs_pos_of_{}; // 代价矩阵对应的各键值所在的键位
+    bool costs_valid_{false}; // 代价矩阵是否已经填充
 
 private:
     inline static Config& cfg_ = Config::getInstance();
 
+    static constexpr uz MAX_PATCHED_KEYS = 8; // 移动的键值超过此数时重新填充整个代价矩阵
+
+    static auto fillCosts(const std::array<Pos, KEY_COUNT>& pos_of, std::span<fz> costs) noexcept -> void;
+    static auto patchCosts(const std::array<Pos, KEY_COUNT>& pos_of, uz id, std::span<fz> costs) noexcept -> void;
+    static auto positionsOf(const Layout& layout) noexcept -> std::array<Pos, KEY_COUNT>;
+    static auto trigramRow(const fz* freqs, fz cost_ab, const fz* costs_b) noexcept -> fz;
+
+    auto syncCosts(const std::array<Pos, KEY_COUNT>& pos_of) noexcept -> void;
+    auto denseCost(const fz* costs) const noexcept -> fz;
+    auto denseCostAround(uz id1, uz id2, const fz* costs) const noexcept -> fz;
+    auto countFlaws(const Layout& layout) const noexcept -> uz;
+
     friend class clubmoss::Evaluator;
 };
 
@@ -13,9 +13,7 @@ Data::Data(const Toml& data) {
             )
         );
     }
-    for (const auto& [i, node] : bigram_data.as_table()
-         | std::views::take(MAX_RECORDS)
-         | std::views::enumerate) {
+    for (const auto& [i, node] : bigram_data.as_table() | std::views::enumerate) {
         validateRecord(node.first, 2, bigram_data, i + 1);
         bigram_records_.emplace_back(node);
     }
@@ -30,14 +28,75 @@ Data::Data(const Toml& data) {
             )
         );
     }
-    for (const auto& [i, node] : trigram_data.as_table()
-         | std::views::take(MAX_RECORDS)
-         | std::views::enumerate) {
+    for (const auto& [i, node] : trigram_data.as_table() | std::views::enumerate) {
         validateRecord(node.first, 3, trigram_data, i + 1);
         trigram_records_.emplace_back(node);
     }
     std::ranges::sort(bigram_records_, std::greater<Bigram>());
     std::ranges::sort(trigram_records_, std::greater<Trigram>());
+    build();
+}
+
+/**
+ * @brief 从编译后的语料中加载 n-gram 频率, 记录在编译时已经过校验与排序.
+ **/
+Data::Data(const Corpus& corpus, const Language language) {
+    loadRecords(corpus.records(language, corpus::Section::Bigrams), bigram_records_);
+    loadRecords(corpus.records(language, corpus::Section::Trigrams), trigram_records_);
+    build();
+}
+
+auto Data::isDense() const noexcept -> bool {
+    return dense_;
+}
+
+/**
+ * @brief 根据记录数选择表示方式: 记录较少时逐条计算, 否则将全部记录展开为稠密的张量.
+ * @note 稀疏表示的开销随记录数线性增长, 稠密表示的开销固定, 且覆盖完整的分布.
+ **/
+auto Data::build() -> void {
+    dense_ = bigram_records_.size() > MAX_RECORDS or trigram_records_.size() > MAX_RECORDS;
+    // 建立键值到记录的索引, 以便在交换按键后只更新受影响的记录; 稠密表示下只用于更新缺陷数
+    buildIndex(bigram_records_, related_bigrams_);
+    buildIndex(trigram_records_, related_trigrams_);
+    if (not dense_) return;
+    bigram_tensor_.assign(BIGRAM_TENSOR_SIZE, 0.0);
+    trigram_tensor_.assign(TRIGRAM_TENSOR_SIZE, 0.0);
+    for (const Bigram& bigram : bigram_records_) {
+        const uz a = ID_OF[bigram.caps[0]], b = ID_OF[bigram.caps[1]];
+        bigram_tensor_[a * KEY_CNT_POW2 + b] += bigram.frequencty;
+    }
+    for (const Trigram& trigram : trigram_records_) {
+        const uz a = ID_OF[trigram.caps[0]], b = ID_OF[trigram.caps[1]], c = ID_OF[trigram.caps[2]];
+        trigram_tensor_[(a * KEY_COUNT + b) * KEY_CNT_POW2 + c] += trigram.frequencty;
+    }
+}
+
+template <uz N>
+auto Data::loadRecords(const std::span<const corpus::Record> records, std::vector<Ngram<N>>& ngrams) -> void {
+    ngrams.reserve(records.size());
+    for (const corpus::Record& record : records) {
+        Ngram<N>& ngram = ngrams.emplace_back();
+        for (uz i = 0; i < N; ++i) {
+            ngram.caps[i] = static_cast<Cap>(record.caps[i]);
+        }
+        ngram.frequencty = static_cast<fz>(record.freq);
+    }
+}
+
+template <uz N>
+auto Data::buildIndex(
+    const std::vector<Ngram<N>>& records,
+    std::array<std::vector<uz>, MAX_KEY_CODE>& related
+) -> void {
+    for (const auto& [i, ngram] : records | std::views::enumerate) {
+        for (auto it = ngram.caps.begin(); it != ngram.caps.end(); ++it) {
+            // 同一条记录中重复出现的键值只需索引一次
+            if (std::find(ngram.caps.begin(), it, *it) == it) {
+                related[*it].emplace_back(i);
+            }
+        }
+    }
 }
 
 auto Data::validateRecord(
@@ -2,6 +2,7 @@
 #define CLUBMOSS_SEQ_COST_DATA_HXX
 
 #include "../metric_config.hxx"
+#include "../corpus.hxx"
 
 namespace clubmoss::metric::seq_cost {
 
@@ -10,20 +11,54 @@ public:
     Data() = delete;
 
     explicit Data(const Toml& data);
+    Data(const Corpus& corpus, Language language);
 
-    static constexpr uz MAX_RECORDS = 100;
+    static constexpr uz MAX_RECORDS = 100; // 稀疏表示的最大记录数, 超过时改用稠密表示
+
+    static constexpr uz BIGRAM_TENSOR_SIZE = KEY_COUNT * KEY_CNT_POW2;
+    static constexpr uz TRIGRAM_TENSOR_SIZE = KEY_COUNT * KEY_COUNT * KEY_CNT_POW2;
+
+    // 键值 -> 稠密编号, 即键值在 CAP_SET 中的下标
+    static constexpr std::array<u8, MAX_KEY_CODE> ID_OF = [] -> auto {
+        std::array<u8, MAX_KEY_CODE> temp{};
+        for (uz i = 0; i < KEY_COUNT; ++i) {
+            temp[CAP_SET[i]] = static_cast<u8>(i);
+        }
+        return temp;
+    }();
+
+    [[nodiscard]] auto isDense() const noexcept -> bool;
 
 protected:
+    // 按频率从高到低排列的记录; 稠密表示下仍用于检查最常用的 n-gram
     std::vector<Ngram<2>> bigram_records_{};
     std::vector<Ngram<3>> trigram_records_{};
 
+    // 索引均按记录的排名升序排列
+    std::array<std::vector<uz>, MAX_KEY_CODE> related_bigrams_{}; // 键值 -> 涉及该键值的 2-gram 记录的索引
+    std::array<std::vector<uz>, MAX_KEY_CODE> related_trigrams_{}; // 键值 -> 涉及该键值的 3-gram 记录的索引
+
+    // 稠密表示, 以稠密编号为下标, 最内层补齐到 KEY_CNT_POW2 以便向量化
+    bool dense_{false};
+    AlignedVector<fz> bigram_tensor_{}; // [a][b] -> 频率
+    AlignedVector<fz> trigram_tensor_{}; // [a][b][c] -> 频率
+
 private:
     static auto validateRecord(std::string_view ngram, uz n, const Toml& data, uz line) -> void;
 
+    auto build() -> void;
+
+    template <uz N>
+    static auto loadRecords(std::span<const corpus::Record> records, std::vector<Ngram<N>>& ngrams) -> void;
+
+    template <uz N>
+    static auto buildIndex(const std::vector<Ngram<N>>& records, std::array<std::vector<uz>, MAX_KEY_CODE>& related) -> void;
+
     static constexpr char WHAT[]{"Illegal n-gram-frequency data: {:s}"};
     using IllegalData = IllegalToml<WHAT>;
 
     friend class clubmoss::metric::SeqCost;
+    friend class clubmoss::metric::Corpus;
 };
 
 }
@@ -0,0 +1,105 @@
+#include "checkpoint.hxx"
+
+namespace clubmoss {
+
+/**
+ * @param sub_path 检查点文件相对于项目根目录的路径.
+ * @param sources 决定检查点是否有效的源文件, 其中任何一个发生变化都会使旧的检查点失效.
+ **/
+Checkpoint::Checkpoint(const std::string_view sub_path, const std::initializer_list<std::string_view> sources)
+    : path_(Utils::absPath(sub_path)), fingerprint_(Utils::fingerprintOf(sources)) {}
+
+/**
+ * @brief 创建写入器, 并写入文件头.
+ **/
+auto Checkpoint::writer() const -> Writer {
+    Writer writer(path_, fingerprint_);
+    writer.write(MAGIC).write(VERSION).write(fingerprint_);
+    return writer;
+}
+
+/**
+ * @brief 打开检查点文件, 并校验文件头.
+ * @return 读取器; 如果文件不存在, 或者由其他版本或其他配置生成, 则返回空值.
+ **/
+auto Checkpoint::reader() const -> std::optional<Reader> {
+    std::ifstream is(path_, std::ios::in | std::ios::binary);
+    if (not is.is_open()) {
+        return std::nullopt;
+    }
+
+    Reader reader(std::move(is));
+    uint64_t magic{};
+    uint32_t version{};
+    Hash fingerprint{};
+    try {
+        reader.read(magic).read(version).read(fingerprint);
+    } catch (const FatalError&) {
+        spdlog::warn("Ignored truncated checkpoint \"{:s}\".", path_);
+        return std::nullopt;
+    }
+    if (magic != MAGIC or version != VERSION or fingerprint != fingerprint_) {
+        spdlog::warn("Ignored outdated checkpoint \"{:s}\".", path_);
+        return std::nullopt;
+    }
+    return reader;
+}
+
+/**
+ * @brief 删除检查点文件, 在搜索正常结束后调用.
+ **/
+auto Checkpoint::remove() const noexcept -> void {
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+}
+
+Checkpoint::Writer::Writer(std::string path, const Hash fingerprint)
+    : path_(std::move(path)), tmp_path_(std::format("{:s}.{:016x}.tmp", path_, fingerprint)),
+      os_(tmp_path_, std::ios::out | std::ios::binary | std::ios::trunc) {}
+
+/**
+ * @brief 写入布局的按键序列.
+ **/
+auto Checkpoint::Writer::write(const Layout& layout) -> Writer& {
+    const std::string seq = layout.toString();
+    os_.write(seq.data(), static_cast<std::streamsize>(seq.size()));
+    return *this;
+}
+
+/**
+ * @brief 关闭临时文件, 并用它替换旧的检查点文件.
+ * @return 是否成功; 失败时保留旧的检查点文件.
+ **/
+auto Checkpoint::Writer::commit() -> bool {
+    os_.close();
+    std::error_code ec;
+    if (os_.fail()) {
+        std::filesystem::remove(tmp_path_, ec);
+        spdlog::warn("Failed to write checkpoint \"{:s}\".", path_);
+        return false;
+    }
+    std::filesystem::rename(tmp_path_, path_, ec);
+    if (ec) {
+        std::filesystem::remove(tmp_path_, ec);
+        spdlog::warn("Failed to replace checkpoint \"{:s}\".", path_);
+        return false;
+    }
+    return true;
+}
+
+Checkpoint::Reader::Reader(std::ifstream is) : is_(std::move(is)) {}
+
+/**
+ * @brief 读取布局的按键序列.
+ * @throws FatalError 如果文件在读取完成前结束, 或者读取的序列不是合法的布局.
+ **/
+auto Checkpoint::Reader::read(Layout& layout) -> Reader& {
+    std::string seq(KEY_COUNT, '\0');
+    if (not is_.read(seq.data(), static_cast<std::streamsize>(seq.size()))) {
+        throw Corrupted("unexpected end of file");
+    }
+    layout = Layout(seq);
+    return *this;
+}
+
+}
@@ -0,0 +1,101 @@
+#ifndef CLUBMOSS_CHECKPOINT_HXX
+#define CLUBMOSS_CHECKPOINT_HXX
+
+#include "../../layout/layout.hxx"
+
+namespace clubmoss {
+
+// 可按字节直接写入检查点的值, 布局以按键序列的形式单独处理 //
+template <typename T>
+concept CheckpointValue = std::is_trivially_copyable_v<T> and not std::derived_from<T, Layout>;
+
+// 二进制检查点文件, 用于从中断处恢复耗时较长的搜索 //
+class Checkpoint {
+public:
+    class Writer;
+    class Reader;
+
+    Checkpoint(std::string_view sub_path, std::initializer_list<std::string_view> sources);
+
+    [[nodiscard]] auto writer() const -> Writer;
+    [[nodiscard]] auto reader() const -> std::optional<Reader>;
+
+    auto remove() const noexcept -> void;
+
+    // 顺序写入检查点内容, 提交时以临时文件原子地替换旧文件 //
+    class Writer {
+    public:
+        Writer(std::string path, Hash fingerprint);
+
+        template <CheckpointValue T>
+        auto write(const T& value) -> Writer&;
+        auto write(const Layout& layout) -> Writer&;
+
+        auto commit() -> bool;
+
+    private:
+        std::string path_;
+        std::string tmp_path_;
+        std::ofstream os_;
+    };
+
+    // 按写入顺序读取检查点内容 //
+    class Reader {
+    public:
+        explicit Reader(std::ifstream is);
+
+        template <CheckpointValue T>
+        auto read(T& value) -> Reader&;
+        auto read(Layout& layout) -> Reader&;
+
+    private:
+        std::ifstream is_;
+    };
+
+private:
+    std::string path_;
+    Hash fingerprint_;
+
+    static constexpr uint64_t MAGIC{0x54504B43534D4C43}; // "CLMSCKPT"
+    static constexpr uint32_t VERSION{3};
+
+    class Corrupted final : public FatalError {
+    public:
+        Corrupted() = delete;
+
+        explicit Corrupted(const std::string_view msg) noexcept
+            : FatalError(std::format(WHAT, msg)) {}
+
+    private:
+        static constexpr auto WHAT{"Corrupted checkpoint: {:s}"};
+    };
+};
+
+/**
+ * @brief 写入一个可平凡复制的值.
+ * @param value 待写入的值.
+ * @return 写入器自身, 便于链式调用.
+ **/
+template <CheckpointValue T>
+auto Checkpoint::Writer::write(const T& value) -> Writer& {
+    os_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    return *this;
+}
+
+/**
+ * @brief 读取一个可平凡复制的值.
+ * @param value 用于接收读取结果的变量.
+ * @return 读取器自身, 便于链式调用.
+ * @throws FatalError 如果文件在读取完成前结束.
+ **/
+template <CheckpointValue T>
+auto Checkpoint::Reader::read(T& value) -> Reader& {
+    if (not is_.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw Corrupted("unexpected end of file");
+    }
+    return *this;
+}
+
+}
+
+#endif //CLUBMOSS_CHECKPOINT_HXX
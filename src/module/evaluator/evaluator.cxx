@@ -1,42 +1,17 @@
 #include "evaluator.hxx"
 
 namespace clubmoss {
-Evaluator::Evaluator() {
-    initMetrics();
-}
-
-Evaluator::Evaluator(const Evaluator&) {
-    if (metrics_.empty()) {
-        initMetrics();
-    }
-}
-
-Evaluator& Evaluator::operator=(const Evaluator&) {
-    if (metrics_.empty()) {
-        initMetrics();
-    }
-    return *this;
-}
+Evaluator::Evaluator() : metrics_(makeMetrics()) {}
 
-auto Evaluator::initMetrics() -> void {
+auto Evaluator::makeMetrics() -> Metrics {
     using R = Resources;
-    for (const MetricId metric : MetricId::_values()) {
-        for (const Language lang : Language::_values()) {
-            switch (metric._value) {
-            case MetricId::KeyCost:
-                metrics_.emplace_back(metric::KeyCost(R::KC_DATA[lang]));
-                break;
-            case MetricId::DisCost:
-                metrics_.emplace_back(metric::DisCost(R::DC_DATA[lang]));
-                break;
-            case MetricId::SeqCost:
-                metrics_.emplace_back(metric::SeqCost(R::SC_DATA[lang]));
-                break;
-            default:
-                throw FatalError("Invalid metric id");
-            }
-        }
-    }
+    constexpr uz ZH = Language::Chinese;
+    constexpr uz EN = Language::English;
+    return {
+        metric::KeyCost(R::KC_DATA[ZH]), metric::KeyCost(R::KC_DATA[EN]),
+        metric::DisCost(R::DC_DATA[ZH]), metric::DisCost(R::DC_DATA[EN]),
+        metric::SeqCost(R::SC_DATA[ZH]), metric::SeqCost(R::SC_DATA[EN]),
+    };
 }
 
 auto Evaluator::loadEnabledFlags() -> void {
@@ -49,26 +24,48 @@ auto Evaluator::loadEnabledFlags() -> void {
 }
 
 auto Evaluator::measure(Sample& sample) const noexcept -> void {
-    for (uz i = 0; i < metrics_.size(); ++i) {
-        sample.raw_costs_[i] = enabled_[i] ? metrics_[i].measure(sample) : 0.0;
-    }
+    forEachTask([&](const uz i, auto& metric) {
+        sample.raw_costs_[i] = enabled_[i] ? metric.measure(sample) : 0.0;
+    });
     sample.calcLoss();
 }
 
 auto Evaluator::analyze(Sample& sample) const noexcept -> void {
-    for (uz i = 0; i < metrics_.size(); ++i) {
+    forEachTask([&](const uz i, auto& metric) {
         if (enabled_[i]) {
-            const auto [fst, snd] = metrics_[i].analyze(sample);
+            const auto [fst, snd] = metric.analyze(sample, sample.states_[i]);
             sample.raw_costs_[i] = fst;
             sample.flaw_cnt_[i] = snd;
         } else {
             sample.raw_costs_[i] = 0.0;
             sample.flaw_cnt_[i] = 0;
         }
-    }
+    });
     sample.calcLossWithPenalty();
 }
 
+/**
+ * @brief 增量地评估由 parent 交换两个按键而得到的 child.
+ * @param child 待评估的样本, 应当由 parent 交换 pos1 与 pos2 上的按键得到.
+ * @param parent 作为参照的样本, 应当已经由 analyze() 或 update() 评估过.
+ * @param pos1 第一个键位.
+ * @param pos2 第二个键位.
+ **/
+auto Evaluator::update(Sample& child, const Sample& parent, const Pos pos1, const Pos pos2) const noexcept -> void {
+    child.states_ = parent.states_;
+    forEachTask([&](const uz i, auto& metric) {
+        if (enabled_[i]) {
+            const auto [fst, snd] = metric.update(child, pos1, pos2, child.states_[i]);
+            child.raw_costs_[i] = fst;
+            child.flaw_cnt_[i] = snd;
+        } else {
+            child.raw_costs_[i] = 0.0;
+            child.flaw_cnt_[i] = 0;
+        }
+    });
+    child.calcLossWithPenalty();
+}
+
 auto Evaluator::evaluate(Sample& sample) const noexcept -> std::string {
     const toml::ordered_table lang_stats{
         {"heat_map", toml::array{}},
@@ -82,20 +79,12 @@ auto Evaluator::evaluate(Sample& sample) const noexcept -> std::string {
 
     Toml zh_stats(lang_stats), en_stats(lang_stats);
 
-    for (const MetricId metric : MetricId::_values()) {
-        for (const Language lang : Language::_values()) {
-            const uz i = Utils::taskIdOf(metric, lang);
-            if (lang._value == Language::Chinese) {
-                const auto [fst, snd] = metrics_[i].scan(sample, zh_stats);
-                sample.raw_costs_[i] = fst;
-                sample.flaw_cnt_[i] = snd;
-            } else if (lang._value == Language::English) {
-                const auto [fst, snd] = metrics_[i].scan(sample, en_stats);
-                sample.raw_costs_[i] = fst;
-                sample.flaw_cnt_[i] = snd;
-            }
-        }
-    }
+    forEachTask([&](const uz i, auto& metric) {
+        Toml& target = (i % Language::_size() == Language::Chinese) ? zh_stats : en_stats;
+        const auto [fst, snd] = metric.scan(sample, target);
+        sample.raw_costs_[i] = fst;
+        sample.flaw_cnt_[i] = snd;
+    });
     sample.calcLossWithPenalty();
 
     const Toml stats(
@@ -114,7 +103,159 @@ auto Evaluator::evaluate(Sample& sample) const noexcept -> std::string {
 }
 
 auto Evaluator::measure(Sample& sample, const uz task_id) const noexcept -> void {
-    sample.loss_ = metrics_[task_id].measure(sample);
+    visitTask(task_id, [&](auto& metric) {
+        sample.loss_ = metric.measure(sample);
+    });
+}
+
+auto Evaluator::analyze(Sample& sample, const uz task_id) const noexcept -> void {
+    visitTask(task_id, [&](auto& metric) {
+        sample.loss_ = metric.analyze(sample, sample.states_[task_id]).first;
+    });
+}
+
+auto Evaluator::update(
+    Sample& child, const Sample& parent,
+    const Pos pos1, const Pos pos2, const uz task_id
+) const noexcept -> void {
+    child.states_[task_id] = parent.states_[task_id];
+    visitTask(task_id, [&](auto& metric) {
+        child.loss_ = metric.update(child, pos1, pos2, child.states_[task_id]).first;
+    });
+}
+
+/**
+ * @brief 批量计算多个布局的损失 (不含缺陷惩罚), 不分配额外内存.
+ * @param layouts 待评估的布局.
+ * @param losses 输出的损失, 长度应与 layouts 相同.
+ * @note 外层循环遍历任务, 内层循环遍历布局, 使同一指标的数据在缓存中保持热度.
+ **/
+auto Evaluator::measureBatch(const std::span<const Layout> layouts, const std::span<fz> losses) const noexcept -> void {
+    assert(layouts.size() == losses.size());
+    std::ranges::fill(losses, 0.0);
+    forEachTask([&](const uz i, auto& metric) {
+        if (not enabled_[i]) return;
+        for (uz j = 0; j < layouts.size(); ++j) {
+            losses[j] += lossOf(i, metric.measure(layouts[j]));
+        }
+    });
+}
+
+/**
+ * @brief 批量完整地评估多个布局 (含缺陷惩罚), 结果与 analyze(Sample&) 一致, 不分配额外内存.
+ * @param layouts 待评估的布局.
+ * @param losses 输出的损失, 长度应与 layouts 相同.
+ * @param raw_costs 输出的各项原始代价, 按布局依次排列, 长度应为 layouts.size() * TASK_COUNT.
+ * @param flaws 输出的缺陷数, 长度应与 layouts 相同.
+ **/
+auto Evaluator::analyzeBatch(
+    const std::span<const Layout> layouts, const std::span<fz> losses,
+    const std::span<fz> raw_costs, const std::span<uz> flaws
+) const noexcept -> void {
+    assert(layouts.size() == losses.size() and layouts.size() == flaws.size());
+    assert(raw_costs.size() == layouts.size() * TASK_COUNT);
+    std::ranges::fill(raw_costs, 0.0);
+    std::ranges::fill(flaws, 0);
+    forEachTask([&](const uz i, auto& metric) {
+        if (not enabled_[i]) return;
+        for (uz j = 0; j < layouts.size(); ++j) {
+            const auto [fst, snd] = metric.analyze(layouts[j]);
+            raw_costs[j * TASK_COUNT + i] = fst;
+            flaws[j] += snd;
+        }
+    });
+    for (uz j = 0; j < layouts.size(); ++j) {
+        std::array<fz, TASK_COUNT> costs{};
+        std::ranges::copy(raw_costs.subspan(j * TASK_COUNT, TASK_COUNT), costs.begin());
+        losses[j] = Sample::lossOf(costs) + Sample::FLAW_PENALTY * static_cast<fz>(flaws[j]);
+    }
+}
+
+/**
+ * @brief 完整地评估种群中编号为 i 的样本.
+ * @param population 样本所在的种群.
+ * @param i 样本编号.
+ **/
+auto Evaluator::analyze(Population& population, const uz i) const noexcept -> void {
+    const Layout& layout = population.layouts_[i];
+    Population::States& states = population.states_[i];
+    fz loss = 0.0;
+    uz flaws = 0;
+    forEachTask([&](const uz t, auto& metric) {
+        fz cost = 0.0;
+        if (enabled_[t]) {
+            const auto [fst, snd] = metric.analyze(layout, states[t]);
+            cost = fst;
+            flaws += snd;
+        }
+        population.raw_costs_[t][i] = cost;
+        loss += lossOf(t, cost);
+    });
+    population.flaws_[i] = flaws;
+    population.losses_[i] = loss + Sample::FLAW_PENALTY * static_cast<fz>(flaws);
+}
+
+/**
+ * @brief 增量地评估种群中由 parent 交换两个按键而得到的 child.
+ * @param population 样本所在的种群.
+ * @param child 待评估的样本编号.
+ * @param parent 作为参照的样本编号.
+ * @param pos1 第一个键位.
+ * @param pos2 第二个键位.
+ **/
+auto Evaluator::update(
+    Population& population, const uz child, const uz parent,
+    const Pos pos1, const Pos pos2
+) const noexcept -> void {
+    const Layout& layout = population.layouts_[child];
+    Population::States& states = population.states_[child];
+    states = population.states_[parent];
+    fz loss = 0.0;
+    uz flaws = 0;
+    forEachTask([&](const uz t, auto& metric) {
+        fz cost = 0.0;
+        if (enabled_[t]) {
+            const auto [fst, snd] = metric.update(layout, pos1, pos2, states[t]);
+            cost = fst;
+            flaws += snd;
+        }
+        population.raw_costs_[t][child] = cost;
+        loss += lossOf(t, cost);
+    });
+    population.flaws_[child] = flaws;
+    population.losses_[child] = loss + Sample::FLAW_PENALTY * static_cast<fz>(flaws);
+}
+
+auto Evaluator::analyze(Population& population, const uz i, const uz task_id) const noexcept -> void {
+    visitTask(task_id, [&](auto& metric) {
+        const fz cost = metric.analyze(population.layouts_[i], population.states_[i][task_id]).first;
+        population.raw_costs_[task_id][i] = cost;
+        population.losses_[i] = cost;
+    });
+}
+
+auto Evaluator::update(
+    Population& population, const uz child, const uz parent,
+    const Pos pos1, const Pos pos2, const uz task_id
+) const noexcept -> void {
+    metric::State& state = population.states_[child][task_id];
+    state = population.states_[parent][task_id];
+    visitTask(task_id, [&](auto& metric) {
+        const fz cost = metric.update(population.layouts_[child], pos1, pos2, state).first;
+        population.raw_costs_[task_id][child] = cost;
+        population.losses_[child] = cost;
+    });
+}
+
+/**
+ * @brief 计算单项任务对损失的贡献, 与 Sample::calcLoss() 一致.
+ * @param task_id 任务编号.
+ * @param raw_cost 原始代价.
+ * @return 经过归一化与加权的代价.
+ **/
+auto Evaluator::lossOf(const uz task_id, const fz raw_cost) noexcept -> fz {
+    const fz cost = (raw_cost - Sample::biases_[task_id]) / Sample::ranges_[task_id];
+    return std::clamp(cost, 0.0, 1.0) * Sample::weights_[task_id];
 }
 
 }
@@ -1,7 +1,7 @@
 #ifndef CLUBMOSS_EVALUATOR_HXX
 #define CLUBMOSS_EVALUATOR_HXX
 
-#include "sample.hxx"
+#include "population.hxx"
 #include "../resources.hxx"
 
 namespace clubmoss {
@@ -10,32 +10,86 @@ class Evaluator {
 public:
     Evaluator();
 
-    Evaluator(const Evaluator&);
-    Evaluator& operator=(const Evaluator&);
-
     auto measure(Sample& sample) const noexcept -> void;
     auto analyze(Sample& sample) const noexcept -> void;
 
     auto evaluate(Sample& sample) const noexcept -> std::string;
 
+    auto update(Sample& child, const Sample& parent, Pos pos1, Pos pos2) const noexcept -> void;
+
     auto measure(Sample& sample, uz task_id) const noexcept -> void;
+    auto analyze(Sample& sample, uz task_id) const noexcept -> void;
+    auto update(Sample& child, const Sample& parent, Pos pos1, Pos pos2, uz task_id) const noexcept -> void;
+
+    auto measureBatch(std::span<const Layout> layouts, std::span<fz> losses) const noexcept -> void;
+    auto analyzeBatch(
+        std::span<const Layout> layouts, std::span<fz> losses, std::span<fz> raw_costs, std::span<uz> flaws
+    ) const noexcept -> void;
+
+    auto analyze(Population& population, uz i) const noexcept -> void;
+    auto update(Population& population, uz child, uz parent, Pos pos1, Pos pos2) const noexcept -> void;
+
+    auto analyze(Population& population, uz i, uz task_id) const noexcept -> void;
+    auto update(Population& population, uz child, uz parent, Pos pos1, Pos pos2, uz task_id) const noexcept -> void;
 
 protected:
-    std::vector<Metric> metrics_;
+    // 各项任务的指标, 按 Utils::taskIdOf() 的顺序排列, 在编译期静态分派 //
+    using Metrics = std::tuple<
+        metric::KeyCost, metric::KeyCost,
+        metric::DisCost, metric::DisCost,
+        metric::SeqCost, metric::SeqCost
+    >;
+
+    static_assert(std::tuple_size_v<Metrics> == TASK_COUNT);
+
+    // 指标在计算时会更新其内部缓存, 但不影响评估结果 //
+    mutable Metrics metrics_;
 
-    auto initMetrics() -> void;
+    static auto makeMetrics() -> Metrics;
 
 private:
     inline static std::array<bool, TASK_COUNT> enabled_{};
 
     static auto loadEnabledFlags() -> void;
 
+    static auto lossOf(uz task_id, fz raw_cost) noexcept -> fz;
+
     inline static const bool dummy = (
         loadEnabledFlags(), true
     );
 
+    template <typename F>
+    auto forEachTask(F&& f) const noexcept -> void;
+
+    template <typename F>
+    auto visitTask(uz task_id, F&& f) const noexcept -> void;
+
 };
 
+/**
+ * @brief 依次对每一项任务调用 f(task_id, metric), 循环在编译期展开.
+ * @param f 回调函数, task_id 以 std::integral_constant 的形式传入.
+ **/
+template <typename F>
+auto Evaluator::forEachTask(F&& f) const noexcept -> void {
+    [&]<uz... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<uz, I>{}, std::get<I>(metrics_)), ...);
+    }(std::make_index_sequence<TASK_COUNT>{});
+}
+
+/**
+ * @brief 对编号为 task_id 的任务调用 f(metric).
+ * @param task_id 任务编号.
+ * @param f 回调函数.
+ **/
+template <typename F>
+auto Evaluator::visitTask(const uz task_id, F&& f) const noexcept -> void {
+    assert(task_id < TASK_COUNT);
+    [&]<uz... I>(std::index_sequence<I...>) {
+        ((task_id == I ? (f(std::get<I>(metrics_)), true) : false) or ...);
+    }(std::make_index_sequence<TASK_COUNT>{});
+}
+
 }
 
 #endif //CLUBMOSS_EVALUATOR_HXX
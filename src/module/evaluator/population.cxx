@@ -0,0 +1,65 @@
+#include "population.hxx"
+
+namespace clubmoss {
+
+/**
+ * @brief 调整种群大小, 所有样本均被重置为 layout, 并按编号排列.
+ * @param size 样本数.
+ * @param layout 初始布局.
+ **/
+auto Population::resize(const uz size, const Layout& layout) -> void {
+    layouts_.assign(size, layout);
+    states_.assign(size, States{});
+    losses_.assign(size, std::numeric_limits<fz>::max());
+    flaws_.assign(size, 0);
+    for (AlignedVector<fz>& costs : raw_costs_) {
+        costs.assign(size, 0.0);
+    }
+    order_.resize(size);
+    std::iota(order_.begin(), order_.end(), 0uz);
+    buffer_.resize(size);
+}
+
+auto Population::size() const noexcept -> uz {
+    return layouts_.size();
+}
+
+auto Population::indexOf(const uz rank) const noexcept -> uz {
+    assert(rank < order_.size());
+    return order_[rank];
+}
+
+auto Population::layout(const uz i) noexcept -> Layout& {
+    return layouts_[i];
+}
+
+auto Population::layout(const uz i) const noexcept -> const Layout& {
+    return layouts_[i];
+}
+
+auto Population::loss(const uz i) const noexcept -> fz {
+    return losses_[i];
+}
+
+auto Population::flaws(const uz i) const noexcept -> uz {
+    return flaws_[i];
+}
+
+/**
+ * @brief 将编号为 i 的样本复制为独立的 Sample 对象.
+ * @param i 样本编号.
+ * @return 包含布局, 损失, 原始代价与缓存状态的样本.
+ **/
+auto Population::toSample(const uz i) const -> Sample {
+    Sample sample(layouts_[i]);
+    sample.loss_ = losses_[i];
+    sample.flaws_ = flaws_[i];
+    sample.states_ = states_[i];
+    for (uz task_id = 0; task_id < TASK_COUNT; ++task_id) {
+        sample.raw_costs_[task_id] = raw_costs_[task_id][i];
+        sample.flaw_cnt_[task_id] = states_[i][task_id].flaws;
+    }
+    return sample;
+}
+
+}
@@ -0,0 +1,124 @@
+#ifndef CLUBMOSS_POPULATION_HXX
+#define CLUBMOSS_POPULATION_HXX
+
+#include <omp.h>
+
+#include "sample.hxx"
+
+namespace clubmoss {
+
+class Evaluator;
+
+// 以结构体数组 (SoA) 形式连续存储的样本种群 //
+class Population {
+public:
+    using States = std::array<metric::State, TASK_COUNT>;
+
+    Population() = default;
+
+    auto resize(uz size, const Layout& layout) -> void;
+
+    [[nodiscard]] auto size() const noexcept -> uz;
+
+    [[nodiscard]] auto indexOf(uz rank) const noexcept -> uz;
+
+    [[nodiscard]] auto layout(uz i) noexcept -> Layout&;
+    [[nodiscard]] auto layout(uz i) const noexcept -> const Layout&;
+    [[nodiscard]] auto loss(uz i) const noexcept -> fz;
+    [[nodiscard]] auto flaws(uz i) const noexcept -> uz;
+
+    [[nodiscard]] auto toSample(uz i) const -> Sample;
+
+    template <typename Compare>
+    auto sort(Compare comp) -> void;
+
+    template <typename Compare>
+    auto select(uz survivors, Compare comp) -> void;
+
+protected:
+    std::vector<Layout> layouts_{}; // 布局
+    std::vector<States> states_{}; // 各指标的缓存状态
+
+    AlignedVector<fz> losses_{}; // 损失
+    AlignedVector<uz> flaws_{}; // 缺陷总数
+    std::array<AlignedVector<fz>, TASK_COUNT> raw_costs_{}; // 各任务的原始代价, 按任务分列
+
+    AlignedVector<uz> order_{}; // 按损失排列的样本编号, order_[rank] = i
+    AlignedVector<uz> buffer_{}; // 归并时使用的临时空间
+
+    static constexpr uz PARALLEL_THRESHOLD{2048}; // 超过该规模时并行排序
+
+    template <typename Compare>
+    auto sortRange(uz first, uz last, Compare comp) -> void;
+
+    friend class Evaluator;
+};
+
+/**
+ * @brief 按损失对全部样本重新排序, 只移动样本编号.
+ * @param comp 损失的比较函数.
+ **/
+template <typename Compare>
+auto Population::sort(Compare comp) -> void {
+    sortRange(0, order_.size(), comp);
+}
+
+/**
+ * @brief 截断选择: 将新样本归并入已排序的幸存者中, 使全部样本重新有序.
+ * @param survivors 幸存者数量, 排名 [0, survivors) 的样本应当已经有序.
+ * @param comp 损失的比较函数.
+ * @note 只需对新样本排序, 再进行一次线性归并, 代价远低于完整排序.
+ **/
+template <typename Compare>
+auto Population::select(const uz survivors, Compare comp) -> void {
+    assert(survivors <= order_.size());
+    sortRange(survivors, order_.size(), comp);
+    const auto by_loss = [&](const uz lhs, const uz rhs) { return comp(losses_[lhs], losses_[rhs]); };
+    const auto mid = order_.begin() + static_cast<std::ptrdiff_t>(survivors);
+    buffer_.resize(order_.size());
+    std::merge(order_.begin(), mid, mid, order_.end(), buffer_.begin(), by_loss);
+    std::swap(order_, buffer_);
+}
+
+/**
+ * @brief 对排名 [first, last) 的样本排序. 规模较大时先分块并行排序, 再逐层两两归并.
+ * @param first 起始排名.
+ * @param last 结束排名.
+ * @param comp 损失的比较函数.
+ **/
+template <typename Compare>
+auto Population::sortRange(const uz first, const uz last, Compare comp) -> void {
+    const auto by_loss = [&](const uz lhs, const uz rhs) { return comp(losses_[lhs], losses_[rhs]); };
+    const auto at = [&](const uz rank) { return order_.begin() + static_cast<std::ptrdiff_t>(rank); };
+
+    const uz count = last - first;
+    const uz threads = omp_in_parallel() ? 1 : static_cast<uz>(omp_get_max_threads());
+    const uz chunks = std::min(threads, count / (PARALLEL_THRESHOLD / 2));
+    if (count < PARALLEL_THRESHOLD or chunks <= 1) {
+        std::sort(at(first), at(last), by_loss);
+        return;
+    }
+
+    std::vector<uz> bounds(chunks + 1);
+    for (uz c = 0; c <= chunks; ++c) {
+        bounds[c] = first + count * c / chunks;
+    }
+
+    #pragma omp parallel for schedule(static) default(shared)
+    for (uz c = 0; c < chunks; ++c) {
+        std::sort(at(bounds[c]), at(bounds[c + 1]), by_loss);
+    }
+
+    for (uz width = 1; width < chunks; width *= 2) {
+        #pragma omp parallel for schedule(static) default(shared)
+        for (uz c = 0; c < chunks; c += 2 * width) {
+            const uz mid = std::min(c + width, chunks);
+            const uz end = std::min(c + 2 * width, chunks);
+            std::inplace_merge(at(bounds[c]), at(bounds[mid]), at(bounds[end]), by_loss);
+        }
+    }
+}
+
+}
+
+#endif //CLUBMOSS_POPULATION_HXX
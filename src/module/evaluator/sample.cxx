@@ -27,7 +27,27 @@ auto Sample::calcLossWithPenalty() -> void {
     for (uz i = 0; i < TASK_COUNT; ++i) {
         flaws_ += flaw_cnt_[i];
     }
-    loss_ += 0.01 * flaws_;
+    loss_ += FLAW_PENALTY * static_cast<fz>(flaws_);
+}
+
+/**
+ * @brief 由各项任务的原始代价计算不含缺陷惩罚的损失.
+ * @param raw_costs 各项任务的原始代价.
+ * @note 损失关于每一项原始代价都是单调不减的, 因此代价的下界可以直接转化为损失的下界.
+ **/
+auto Sample::lossOf(const std::array<fz, TASK_COUNT>& raw_costs) noexcept -> fz {
+    fz loss = 0.0;
+    for (uz i = 0; i < TASK_COUNT; ++i) {
+        loss += std::clamp((raw_costs[i] - biases_[i]) / ranges_[i], 0.0, 1.0) * weights_[i];
+    }
+    return loss;
+}
+
+/**
+ * @brief 在未截断时, 某项任务的原始代价每增加 1, 损失的增量.
+ **/
+auto Sample::scaleOf(const uz task_id) noexcept -> fz {
+    return weights_[task_id] / ranges_[task_id];
 }
 
 auto Sample::getLoss() const noexcept -> fz {
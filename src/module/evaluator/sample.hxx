@@ -1,12 +1,13 @@
 #ifndef CLUBMOSS_SAMPLE_HXX
 #define CLUBMOSS_SAMPLE_HXX
 
-#include "../../layout/layout.hxx"
+#include "../../metric/metric.hxx"
 
 namespace clubmoss {
 
 class Evaluator;
 class Optimizer;
+class Population;
 
 class Sample : public Layout {
 public:
@@ -24,6 +25,11 @@ public:
 
     static auto loadCfg(const Toml& score_cfg, const Toml& status) -> void;
 
+    [[nodiscard]] static auto lossOf(const std::array<fz, TASK_COUNT>& raw_costs) noexcept -> fz;
+    [[nodiscard]] static auto scaleOf(uz task_id) noexcept -> fz;
+
+    static constexpr fz FLAW_PENALTY{0.01}; // 每个缺陷的损失惩罚
+
 protected:
     fz loss_{std::numeric_limits<fz>::max()};
     uz rank_{std::numeric_limits<uz>::max()};
@@ -33,6 +39,8 @@ protected:
     std::array<fz, TASK_COUNT> raw_costs_{};
     std::array<uz, TASK_COUNT> flaw_cnt_{};
 
+    std::array<metric::State, TASK_COUNT> states_{}; // 各指标的缓存状态, 用于增量计算
+
 private:
     inline static std::array<fz, TASK_COUNT> biases_{};
     inline static std::array<fz, TASK_COUNT> ranges_{};
@@ -47,6 +55,7 @@ private:
 
     friend class Evaluator;
     friend class Optimizer;
+    friend class Population;
 };
 
 }
@@ -0,0 +1,207 @@
+#include "extractor.hxx"
+#include "../../metric/dis_cost/dis_cost_data.hxx"
+
+namespace clubmoss {
+
+Extractor::Extractor() : locals_(static_cast<uz>(omp_get_max_threads())) {}
+
+/**
+ * @brief 统计一段文本, 可以将一个大文件分成任意多段依次传入.
+ * @param text 文本内容, 只统计合法的键值 (不区分大小写), 其余字节均视为分隔符.
+ * @note 每个 n-gram 在其最后一个字符所在的位置计数, 因此跨段的 n-gram 恰好计数一次.
+ **/
+auto Extractor::feed(const std::string_view text) noexcept -> void {
+    const uz n = text.size();
+    if (n == 0) return;
+
+    // 以上一段末尾的编码补全本段开头的 n-gram
+    const std::array<u8, 4> head{
+        tail_[0], tail_[1], codeOf(text[0]), n > 1 ? codeOf(text[1]) : SEP
+    };
+    for (uz p = 0; p < std::min(n, 2uz); ++p) {
+        locals_.front().count(head[p], head[p + 1], head[p + 2]);
+    }
+
+    const int num_threads = static_cast<int>(locals_.size());
+    #pragma omp parallel num_threads(num_threads) shared(locals_, text, n) default(none)
+    {
+        Counts& local = locals_[static_cast<uz>(omp_get_thread_num())];
+        #pragma omp for schedule(static)
+        for (uz p = 2; p < n; ++p) {
+            local.count(codeOf(text[p - 2]), codeOf(text[p - 1]), codeOf(text[p]));
+        }
+    }
+
+    tail_ = n > 1 ? std::array{codeOf(text[n - 2]), codeOf(text[n - 1])} : std::array{tail_[1], codeOf(text[0])};
+}
+
+/**
+ * @brief 分块读取并统计一个文本文件, 内存占用与文件大小无关.
+ * @param path 文件路径.
+ * @throws FatalError 如果无法打开或读取文件.
+ **/
+auto Extractor::ingest(const std::string& path) -> void {
+    std::ifstream is(path, std::ios::in | std::ios::binary);
+    if (not is.is_open()) {
+        throw FatalError(std::format("Cannot open text file \"{:s}\"", path));
+    }
+    spdlog::info("Extracting n-grams from \"{:s}\"...", path);
+
+    std::string buffer(BLOCK_SIZE, '\0');
+    uz total = 0;
+    while (is) {
+        is.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const auto size = static_cast<uz>(is.gcount());
+        feed(std::string_view(buffer.data(), size));
+        total += size;
+    }
+    if (is.bad()) {
+        throw FatalError(std::format("Failed to read text file \"{:s}\"", path));
+    }
+    // 文件之间以分隔符隔开, 避免首尾相连形成虚假的 n-gram
+    feed(" ");
+    spdlog::info("Processed {:d} bytes.", total);
+}
+
+/**
+ * @brief 合并各线程的计数表, 生成 char.toml, pair.toml 与 seq.toml.
+ * @param sub_dir 输出目录相对于项目根目录的路径 (例如 data/english).
+ * @note 记录按频率从高到低排列, 并且只保留指标实际使用的记录.
+ **/
+auto Extractor::save(const std::string_view sub_dir) -> void {
+    feed(" ");
+    const auto counts = std::make_unique<Counts>();
+    for (const Counts& local : locals_) {
+        counts->merge(local);
+    }
+
+    const std::string dir = Utils::absPath(sub_dir);
+    std::filesystem::create_directories(dir);
+    writeChars(*counts, std::format("{:s}/char.toml", dir));
+    writePairs(*counts, std::format("{:s}/pair.toml", dir));
+    writeSeqs(*counts, std::format("{:s}/seq.toml", dir));
+    spdlog::info("Saved frequency tables to \"{:s}\".", dir);
+}
+
+auto Extractor::Counts::count(const u8 a, const u8 b, const u8 c) noexcept -> void {
+    ++chars[c];
+    ++pairs[b * CODE_COUNT + c];
+    ++trigrams[(a * CODE_COUNT + b) * CODE_COUNT + c];
+}
+
+auto Extractor::Counts::merge(const Counts& other) noexcept -> void {
+    std::ranges::transform(chars, other.chars, chars.begin(), std::plus{});
+    std::ranges::transform(pairs, other.pairs, pairs.begin(), std::plus{});
+    std::ranges::transform(trigrams, other.trigrams, trigrams.begin(), std::plus{});
+}
+
+auto Extractor::codeOf(const char c) noexcept -> u8 {
+    return CODE_OF[static_cast<uint8_t>(c)];
+}
+
+/**
+ * @brief 编码序列 -> 语料文件中的字段名 (小写, 分隔符记为 ' ').
+ **/
+auto Extractor::keyOf(const std::initializer_list<u8> codes) -> std::string {
+    std::string key;
+    for (const u8 code : codes) {
+        key += code == SEP ? ' ' : static_cast<char>(std::tolower(CAP_SET[code]));
+    }
+    return key;
+}
+
+/**
+ * @brief 按频率从高到低写入一张频率表.
+ * @param os 输出流.
+ * @param records 字段名与出现次数.
+ * @param total 用于计算频率的总次数.
+ * @param max_records 最多写入的记录数.
+ * @param min_freq 最低频率, 更罕见的记录不会写入.
+ **/
+auto Extractor::writeTable(
+    std::ostream& os, Records records, const uint64_t total, const uz max_records, const fz min_freq
+) -> void {
+    std::ranges::stable_sort(
+        records, [](const auto& lhs, const auto& rhs) -> bool { return lhs.second > rhs.second; }
+    );
+    if (records.size() > max_records) {
+        records.resize(max_records);
+    }
+    for (const auto& [key, count] : records) {
+        const fz freq = static_cast<fz>(count) / static_cast<fz>(std::max<uint64_t>(total, 1));
+        if (freq < min_freq) break;
+        os << std::format("\"{:s}\"={:.6f}\n", key, freq);
+    }
+}
+
+/**
+ * @brief 写入所有按键的频率; 未出现的按键频率为 0, 将无法通过数据校验.
+ **/
+auto Extractor::writeChars(const Counts& counts, const std::string& path) -> void {
+    Records records;
+    uint64_t total = 0;
+    for (u8 c = 0; c < KEY_COUNT; ++c) {
+        records.emplace_back(keyOf({c}), counts.chars[c]);
+        total += counts.chars[c];
+    }
+    if (std::ranges::any_of(records, [](const auto& record) { return record.second == 0; })) {
+        spdlog::warn("Some keys never appear in the text, the corpus is probably too small.");
+    }
+
+    std::ofstream os(path, std::ios::out | std::ios::trunc);
+    writeTable(os, std::move(records), total, KEY_COUNT, 0.0);
+}
+
+/**
+ * @brief 写入按键对的频率, 包括以分隔符开头或结尾的记录.
+ **/
+auto Extractor::writePairs(const Counts& counts, const std::string& path) -> void {
+    Records records;
+    uint64_t total = 0;
+    for (u8 a = 0; a < CODE_COUNT; ++a) {
+        for (u8 b = 0; b < CODE_COUNT; ++b) {
+            const uint64_t count = counts.pairs[a * CODE_COUNT + b];
+            if (count == 0 or (a == SEP and b == SEP)) continue;
+            records.emplace_back(keyOf({a, b}), count);
+            total += count;
+        }
+    }
+    std::ofstream os(path, std::ios::out | std::ios::trunc);
+    writeTable(os, std::move(records), total, metric::dis_cost::Data::MAX_RECORDS, MIN_FREQ);
+}
+
+/**
+ * @brief 写入不含分隔符的 2-gram 与 3-gram 的频率; 记录较多时指标将使用稠密表示, 因此不限制记录数.
+ **/
+auto Extractor::writeSeqs(const Counts& counts, const std::string& path) -> void {
+    Records bigrams;
+    uint64_t bigram_total = 0;
+    for (u8 a = 0; a < KEY_COUNT; ++a) {
+        for (u8 b = 0; b < KEY_COUNT; ++b) {
+            const uint64_t count = counts.pairs[a * CODE_COUNT + b];
+            if (count == 0) continue;
+            bigrams.emplace_back(keyOf({a, b}), count);
+            bigram_total += count;
+        }
+    }
+    Records trigrams;
+    uint64_t trigram_total = 0;
+    for (u8 a = 0; a < KEY_COUNT; ++a) {
+        for (u8 b = 0; b < KEY_COUNT; ++b) {
+            for (u8 c = 0; c < KEY_COUNT; ++c) {
+                const uint64_t count = counts.trigrams[(a * CODE_COUNT + b) * CODE_COUNT + c];
+                if (count == 0) continue;
+                trigrams.emplace_back(keyOf({a, b, c}), count);
+                trigram_total += count;
+            }
+        }
+    }
+
+    std::ofstream os(path, std::ios::out | std::ios::trunc);
+    os << "[bigram]\n";
+    writeTable(os, std::move(bigrams), bigram_total, std::numeric_limits<uz>::max(), MIN_FREQ);
+    os << "\n[trigram]\n";
+    writeTable(os, std::move(trigrams), trigram_total, std::numeric_limits<uz>::max(), MIN_FREQ);
+}
+
+}
@@ -0,0 +1,70 @@
+#ifndef CLUBMOSS_EXTRACTOR_HXX
+#define CLUBMOSS_EXTRACTOR_HXX
+
+#include <omp.h>
+
+#include "../../common/utils.hxx"
+
+namespace clubmoss {
+
+// 从原始文本中统计字符, 按键对与 n-gram 的频率, 生成指标所需的语料文件 //
+class Extractor {
+public:
+    Extractor();
+
+    Extractor(Extractor&&) = delete;
+    Extractor(const Extractor&) = delete;
+    Extractor& operator=(Extractor&&) = delete;
+    Extractor& operator=(const Extractor&) = delete;
+
+    auto feed(std::string_view text) noexcept -> void;
+    auto ingest(const std::string& path) -> void;
+    auto save(std::string_view sub_dir) -> void;
+
+    static constexpr uz BLOCK_SIZE{16uz << 20}; // 每次读入的字节数
+
+private:
+    static constexpr u8 SEP{KEY_COUNT}; // 分隔符: 空白, 标点, 非 ASCII 字符等
+    static constexpr uz CODE_COUNT{KEY_COUNT + 1};
+    static constexpr fz MIN_FREQ{1e-5}; // 语料数据允许的最低频率
+
+    // 单个线程的计数表, 以编码为下标稠密存储 //
+    struct alignas(64) Counts {
+        std::array<uint64_t, CODE_COUNT> chars{};
+        std::array<uint64_t, CODE_COUNT * CODE_COUNT> pairs{};
+        std::array<uint64_t, CODE_COUNT * CODE_COUNT * CODE_COUNT> trigrams{};
+
+        auto count(u8 a, u8 b, u8 c) noexcept -> void;
+        auto merge(const Counts& other) noexcept -> void;
+    };
+
+    // 字节 -> 编码, 合法的键值 (不区分大小写) 映射到 [0, 30), 其余字节均映射为 SEP
+    static constexpr std::array<u8, 256> CODE_OF = [] -> auto {
+        std::array<u8, 256> temp{};
+        temp.fill(SEP);
+        for (uz i = 0; i < KEY_COUNT; ++i) {
+            temp[CAP_SET[i]] = static_cast<u8>(i);
+            if ('A' <= CAP_SET[i] and CAP_SET[i] <= 'Z') {
+                temp[CAP_SET[i] - 'A' + 'a'] = static_cast<u8>(i);
+            }
+        }
+        return temp;
+    }();
+
+    std::vector<Counts> locals_; // 每个线程独占一份计数表, 只在保存时合并
+    std::array<u8, 2> tail_{SEP, SEP}; // 上一段文本末尾的两个编码, 用于统计跨段的 n-gram
+
+    using Records = std::vector<std::pair<std::string, uint64_t>>;
+
+    static auto codeOf(char c) noexcept -> u8;
+    static auto keyOf(std::initializer_list<u8> codes) -> std::string;
+
+    static auto writeTable(std::ostream& os, Records records, uint64_t total, uz max_records, fz min_freq) -> void;
+    static auto writeChars(const Counts& counts, const std::string& path) -> void;
+    static auto writePairs(const Counts& counts, const std::string& path) -> void;
+    static auto writeSeqs(const Counts& counts, const std::string& path) -> void;
+};
+
+}
+
+#endif //CLUBMOSS_EXTRACTOR_HXX
@@ -0,0 +1,110 @@
+#include <omp.h>
+#include "annealer.hxx"
+
+namespace clubmoss::optimizer {
+
+/**
+ * @brief 并行地运行所有退火链.
+ * @return 所有退火链中的最优损失.
+ **/
+auto Annealer::search() noexcept -> fz {
+    const auto num_threads = static_cast<uz>(omp_get_max_threads());
+    const uz num_chains = cfg_.chains_per_thread_ * num_threads;
+    bests_.assign(num_chains, Sample(mgr_.create()));
+
+    // 限定预算时, 各轮并行的退火链平分剩余的预算, 每条链按其份额完成降温
+    std::atomic<uz> started{0};
+    workers_.prepare();
+    #pragma omp parallel for schedule(dynamic) shared(bests_, num_chains, num_threads, started, control_, workers_) default (none)
+    for (uz i = 0; i < num_chains; ++i) {
+        Worker& worker = workers_.local();
+        const uz rounds_left = (num_chains - started.fetch_add(1, std::memory_order_relaxed) + num_threads - 1) / num_threads;
+        anneal(bests_[i], worker.mgr, worker.evl, control_.isBounded() ? control_.fairShare(rounds_left) : control_);
+    }
+
+    std::ranges::sort(
+        bests_, [](const Sample& lhs, const Sample& rhs) {
+            return lhs.getLoss() < rhs.getLoss();
+        }
+    );
+    return bests_.front().getLoss();
+}
+
+auto Annealer::setControl(const Control& control) noexcept -> void {
+    control_ = control;
+}
+
+/**
+ * @brief 从随机布局出发运行一条退火链.
+ * @param best 用于保存该链找到的最优样本.
+ * @param mgr 当前线程的布局管理器.
+ * @param evl 当前线程的评估器.
+ * @param control 外部控制, 被请求停止时提前结束该链; 限定预算时, 按预算的使用比例加速降温.
+ * @note 每一步由 mgr.mutate() 交换一对按键, 并由 evl.update() 增量地计算损失.
+ **/
+auto Annealer::anneal(
+    Sample& best, layout::Manager& mgr, const Evaluator& evl, const Control& control
+) noexcept -> void {
+    Prng prng(layout::Manager::nextSeed()); // 与布局管理器使用同一种子来源, 以便 setSeed() 后可以复现
+    const auto uniform = [&prng] -> fz {
+        return static_cast<fz>(prng() >> 11) * 0x1.0p-53;
+    };
+
+    std::array samples{Sample(mgr.create()), Sample(mgr.create())};
+    Sample* curr = &samples[0];
+    Sample* next = &samples[1];
+    evl.analyze(*curr);
+    best = *curr;
+
+    fz temperature = cfg_.initial_temperature_;
+    uz accepted = 0;
+    for (uz step = 0; step < cfg_.steps_per_chain_; ++step) {
+        if (step % COOLING_INTERVAL == 0) {
+            control.consume(COOLING_INTERVAL);
+            if (control.stopRequested()) break;
+            const auto budget_step = static_cast<uz>(control.progress() * static_cast<fz>(cfg_.steps_per_chain_));
+            temperature = temperatureAt(std::max(step, budget_step));
+        }
+
+        const auto [pos1, pos2] = mgr.mutate(*next, *curr);
+        evl.update(*next, *curr, pos1, pos2);
+
+        const fz delta = next->getLoss() - curr->getLoss();
+        if (delta <= 0.0 or uniform() < std::exp(-delta / temperature)) {
+            std::swap(curr, next);
+            ++accepted;
+            if (curr->getLoss() < best.getLoss()) {
+                best = *curr;
+            }
+        }
+    }
+
+    spdlog::debug(
+        "Chain finished: loss = {:8.5f}, acceptance = {:6.3f}%",
+        best.getLoss(), static_cast<fz>(accepted) / static_cast<fz>(cfg_.steps_per_chain_) * 100.0
+    );
+}
+
+/**
+ * @brief 计算第 step 步的温度.
+ * @param step 当前步数.
+ * @return 按降温方式插值得到的温度, 在最后一步到达终止温度.
+ **/
+auto Annealer::temperatureAt(const uz step) noexcept -> fz {
+    const fz t0 = cfg_.initial_temperature_;
+    const fz t1 = cfg_.final_temperature_;
+    const fz progress = static_cast<fz>(step) / static_cast<fz>(cfg_.steps_per_chain_);
+    switch (cfg_.schedule_._value) {
+    case CoolingSchedule::Linear:
+        return t0 + (t1 - t0) * progress;
+    case CoolingSchedule::Logarithmic: {
+        const fz scale = std::log1p(static_cast<fz>(step)) / std::log1p(static_cast<fz>(cfg_.steps_per_chain_));
+        return t0 / (1.0 + (t0 / t1 - 1.0) * scale);
+    }
+    case CoolingSchedule::Exponential:
+    default:
+        return t0 * std::pow(t1 / t0, progress);
+    }
+}
+
+}
@@ -0,0 +1,45 @@
+#ifndef CLUBMOSS_OPTIMIZER_ANNEALER_HXX
+#define CLUBMOSS_OPTIMIZER_ANNEALER_HXX
+
+#include "control.hxx"
+#include "workers.hxx"
+#include "optimizer_config.hxx"
+
+namespace clubmoss::optimizer {
+
+// 模拟退火, 每个线程依次运行若干条独立的退火链 //
+class Annealer {
+public:
+    Annealer() = default;
+
+    Annealer(Annealer&&) = delete;
+    Annealer(const Annealer&) = delete;
+    Annealer& operator=(Annealer&&) = delete;
+    Annealer& operator=(const Annealer&) = delete;
+
+    auto search() noexcept -> fz;
+
+    auto setControl(const Control& control) noexcept -> void;
+
+protected:
+    layout::Manager mgr_{}; // 供串行代码使用
+    Workers workers_{}; // 供并行区域使用, 在各次搜索之间复用
+    Control control_{};
+
+    std::vector<Sample> bests_{}; // 每条退火链找到的最优样本, 按损失升序排列
+
+    static auto anneal(Sample& best, layout::Manager& mgr, const Evaluator& evl, const Control& control) noexcept -> void;
+
+    static auto temperatureAt(uz step) noexcept -> fz;
+
+    static constexpr uz COOLING_INTERVAL{256}; // 每隔若干步更新一次温度
+
+private:
+    inline static Config& cfg_ = Config::getInstance();
+
+    friend class clubmoss::Optimizer;
+};
+
+}
+
+#endif //CLUBMOSS_OPTIMIZER_ANNEALER_HXX
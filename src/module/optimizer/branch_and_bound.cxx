@@ -0,0 +1,315 @@
+#include <omp.h>
+#include "branch_and_bound.hxx"
+#include "../../common/assignment.hxx"
+
+namespace clubmoss::optimizer {
+
+BranchAndBound::BranchAndBound() {
+    using R = Resources;
+    for (const Language language : Language::_values()) {
+        models_[Utils::taskIdOf(MetricId::KeyCost, language)] = metric::KeyCost(R::KC_DATA[language]).decompose();
+        models_[Utils::taskIdOf(MetricId::DisCost, language)] = metric::DisCost(R::DC_DATA[language]).decompose();
+        models_[Utils::taskIdOf(MetricId::SeqCost, language)] = metric::SeqCost(R::SC_DATA[language]).decompose();
+    }
+
+    const layout::Config& layout_cfg = layout::Config::getInstance();
+    root_.pos_of.fill(NONE);
+    root_.pos_of[' '] = metric::Config::IDLE_POS;
+    for (const Key& key : layout_cfg.pinnedKeys()) {
+        root_.pos_of[key.cap] = key.pos;
+        root_.used.set(key.pos);
+    }
+    for (const auto& [i, area] : layout_cfg.mutableAreas() | std::views::enumerate) {
+        area_caps_.emplace_back(area.caps().begin(), area.caps().end());
+        area_positions_.emplace_back(area.positions().begin(), area.positions().end());
+        for (const Cap cap : area.caps()) {
+            area_of_[cap] = static_cast<uz>(i);
+            order_.push_back(cap);
+        }
+    }
+
+    // 先为涉及频率最高的键值指定键位, 使下界尽早收紧
+    std::array<fz, MAX_KEY_CODE> involvement{};
+    for (const metric::Decomposition& model : models_) {
+        const fz total = std::accumulate(
+            model.terms.begin(), model.terms.end(), 0.0,
+            [](const fz sum, const metric::Term& term) -> fz { return sum + term.freq; }
+        );
+        if (total <= 0.0) continue;
+        for (const metric::Term& term : model.terms) {
+            for (uz k = 0; k < term.size; ++k) {
+                involvement[term.caps[k]] += term.freq / total;
+            }
+        }
+    }
+    std::ranges::stable_sort(order_, std::greater{}, [&involvement](const Cap cap) { return involvement[cap]; });
+}
+
+/**
+ * @brief 以爬山法生成初始解, 然后并行地搜索整棵搜索树.
+ * @return 最优损失; 节点预算用尽时为目前找到的最优损失.
+ **/
+auto BranchAndBound::search() -> fz {
+    nodes_ = 0;
+    exhausted_ = false;
+    best_loss_ = std::numeric_limits<fz>::max();
+    bests_.clear();
+
+    std::vector<Evaluator> evaluators(static_cast<uz>(omp_get_max_threads()));
+    scratch_.assign(evaluators.size(), std::vector<fz>(MAX_KEY_CODE * KEY_COUNT, 0.0));
+    seed(evaluators);
+    spdlog::info(
+        "Branching over {:d} mutable keys from an initial loss of {:8.5f}...",
+        order_.size(), best_loss_.load()
+    );
+
+    // 浅层节点的子树作为任务提交, 由空闲的线程领取
+    #pragma omp parallel default(shared)
+    #pragma omp single
+    branch(root_, evaluators);
+
+    spdlog::info(
+        "Visited {:d} nodes, best loss = {:8.5f} ({:s}).",
+        nodes_.load(), best_loss_.load(), isCertified() ? "certified optimal" : "node budget exhausted"
+    );
+    return best_loss_;
+}
+
+auto BranchAndBound::setControl(const Control& control) noexcept -> void {
+    control_ = control;
+}
+
+/**
+ * @brief 搜索是否在节点预算内完成, 即结果是否可证明为最优.
+ **/
+auto BranchAndBound::isCertified() const noexcept -> bool {
+    return not exhausted_.load();
+}
+
+auto BranchAndBound::nodes() const noexcept -> uz {
+    return nodes_.load();
+}
+
+/**
+ * @brief 每个线程从一个随机布局出发, 只接受更优的交换, 以得到一个较好的初始上界.
+ **/
+auto BranchAndBound::seed(std::vector<Evaluator>& evaluators) -> void {
+    const int num_threads = static_cast<int>(evaluators.size());
+    #pragma omp parallel num_threads(num_threads) default(shared)
+    {
+        const Evaluator& evl = evaluators[static_cast<uz>(omp_get_thread_num())];
+        layout::Manager mgr;
+        std::array samples{Sample(mgr.create()), Sample(mgr.create())};
+        Sample* curr = &samples[0];
+        Sample* next = &samples[1];
+        evl.analyze(*curr);
+        for (uz step = 0; step < SEED_STEPS; ++step) {
+            const auto [pos1, pos2] = mgr.mutate(*next, *curr);
+            evl.update(*next, *curr, pos1, pos2);
+            if (next->getLoss() < curr->getLoss()) {
+                std::swap(curr, next);
+            }
+        }
+        evl.analyze(*curr);
+        keep(*curr);
+        control_.consume(SEED_STEPS + 2);
+    }
+}
+
+/**
+ * @brief 展开一个节点: 为下一个可变键值依次尝试其区域内的空闲键位.
+ * @param node 待展开的节点.
+ * @param evaluators 各线程的评估器.
+ **/
+auto BranchAndBound::branch(const Node& node, std::vector<Evaluator>& evaluators) -> void {
+    if (exhausted_.load(std::memory_order_relaxed)) return;
+    if (nodes_.fetch_add(1, std::memory_order_relaxed) >= cfg_.max_nodes_ or control_.stopRequested()) {
+        exhausted_.store(true, std::memory_order_relaxed);
+        return;
+    }
+    if (node.depth == order_.size()) {
+        evaluate(node, evaluators[static_cast<uz>(omp_get_thread_num())]);
+        return;
+    }
+
+    std::array<fz, KEY_COUNT> scores{};
+    std::vector<fz>& marginal = scratch_[static_cast<uz>(omp_get_thread_num())];
+    if (lowerBound(node, scores, marginal) - TOLERANCE >= best_loss_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // 按边际代价从低到高尝试各个键位, 以便尽早找到更好的上界
+    const Cap cap = order_[node.depth];
+    std::vector<Pos> candidates;
+    for (const Pos pos : area_positions_[area_of_[cap]]) {
+        if (not node.used[pos]) {
+            candidates.push_back(pos);
+        }
+    }
+    std::ranges::stable_sort(candidates, {}, [&scores](const Pos pos) { return scores[pos]; });
+
+    for (const Pos pos : candidates) {
+        Node child = node;
+        child.pos_of[cap] = pos;
+        child.used.set(pos);
+        ++child.depth;
+        if (node.depth < SPLIT_DEPTH) {
+            #pragma omp task firstprivate(child) shared(evaluators)
+            branch(child, evaluators);
+        } else {
+            branch(child, evaluators);
+        }
+    }
+}
+
+/**
+ * @brief 完整地评估一个叶节点, 计入评估预算.
+ **/
+auto BranchAndBound::evaluate(const Node& node, const Evaluator& evl) -> void {
+    std::string seq(KEY_COUNT, ' ');
+    for (const Cap cap : CAP_SET) {
+        seq[node.pos_of[cap]] = static_cast<char>(cap);
+    }
+    Sample sample{Layout(seq)};
+    evl.analyze(sample);
+    control_.consume(1);
+    keep(sample);
+}
+
+/**
+ * @brief 将样本按损失升序插入 bests_, 只保留前 MAX_BESTS 个, 并更新当前最优损失.
+ **/
+auto BranchAndBound::keep(const Sample& sample) -> void {
+    std::lock_guard lock(mutex_);
+    const auto it = std::ranges::upper_bound(
+        bests_, sample.getLoss(), {}, [](const Sample& s) { return s.getLoss(); }
+    );
+    if (static_cast<uz>(it - bests_.begin()) >= MAX_BESTS) return;
+    if (std::ranges::any_of(bests_, [&sample](const Sample& s) { return s.getHash() == sample.getHash(); })) {
+        return;
+    }
+    bests_.insert(it, sample);
+    if (bests_.size() > MAX_BESTS) {
+        bests_.pop_back();
+    }
+    best_loss_.store(bests_.front().getLoss(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief 求一个节点下所有完整指派的损失的下界.
+ * @param node 节点.
+ * @param scores 用于输出下一个键值位于各键位时的加权边际代价, 用于排列子节点的顺序.
+ * @param marginal 当前线程的边际代价表.
+ * @note 缺陷惩罚总是非负的, 而损失关于各项代价单调不减, 因此各项代价的下界给出损失的下界.
+ **/
+auto BranchAndBound::lowerBound(const Node& node, const std::span<fz> scores, const std::span<fz> marginal) const -> fz {
+    const Cap next = order_[node.depth];
+    std::array<fz, TASK_COUNT> bounds{};
+    std::array<fz, KEY_COUNT> row{};
+    for (uz task_id = 0; task_id < TASK_COUNT; ++task_id) {
+        row.fill(0.0);
+        bounds[task_id] = costBound(models_[task_id], node, next, row, marginal);
+        const fz scale = Sample::scaleOf(task_id);
+        for (uz pos = 0; pos < KEY_COUNT; ++pos) {
+            scores[pos] += scale * row[pos];
+        }
+    }
+    return Sample::lossOf(bounds);
+}
+
+/**
+ * @brief 以 Gilmore-Lawler 式的方法求一项任务的代价下界.
+ * @param model 任务的代价分解.
+ * @param node 节点.
+ * @param next 下一个待指定的键值.
+ * @param row 用于输出 next 位于各键位时的边际代价.
+ * @param marginal 边际代价表 [键值][键位]; 只有未指定的键值所在的行会被清零和读写.
+ * @note 每一项都记在其第一个未指定的键值上:
+ *       只含一个未指定键值的项精确计入; 含两个的二元项取另一个键值在其空闲键位上的最小代价;
+ *       其余的项以 0 为下界. 然后在每个区域内求解线性指派问题, 得到未指定键值的最小总代价.
+ **/
+auto BranchAndBound::costBound(
+    const metric::Decomposition& model, const Node& node, const Cap next,
+    const std::span<fz> row, const std::span<fz> marginal
+) const -> fz {
+    constexpr fz INF = std::numeric_limits<fz>::infinity();
+    for (uz k = node.depth; k < order_.size(); ++k) {
+        std::fill_n(marginal.begin() + order_[k] * KEY_COUNT, KEY_COUNT, 0.0);
+    }
+
+    fz bound = 0.0;
+    for (const metric::Term& term : model.terms) {
+        std::array<Pos, 3> pos{};
+        std::array<Cap, 2> free{};
+        uz num_free = 0;
+        for (uz k = 0; k < term.size; ++k) {
+            pos[k] = node.pos_of[term.caps[k]];
+            if (pos[k] == NONE and std::find(free.begin(), free.begin() + num_free, term.caps[k]) == free.begin() + num_free) {
+                if (num_free == free.size()) {
+                    ++num_free;
+                    break;
+                }
+                free[num_free++] = term.caps[k];
+            }
+        }
+        if (num_free == 0) {
+            bound += term.freq * model.costOf(term, pos);
+            continue;
+        }
+        if (num_free > 2 or (num_free == 2 and term.size != 2)) {
+            continue;
+        }
+
+        const auto place = [&term](std::array<Pos, 3>& trial, const Cap cap, const Pos p) {
+            for (uz k = 0; k < term.size; ++k) {
+                if (term.caps[k] == cap) trial[k] = p;
+            }
+        };
+        const Cap cap = free[0];
+        for (const Pos p : area_positions_[area_of_[cap]]) {
+            if (node.used[p]) continue;
+            std::array<Pos, 3> trial = pos;
+            place(trial, cap, p);
+            fz cost = INF;
+            if (num_free == 1) {
+                cost = model.costOf(term, trial);
+            } else {
+                for (const Pos q : area_positions_[area_of_[free[1]]]) {
+                    if (node.used[q] or q == p) continue;
+                    place(trial, free[1], q);
+                    cost = std::min(cost, model.costOf(term, trial));
+                }
+            }
+            if (cost < INF) {
+                marginal[cap * KEY_COUNT + p] += term.freq * cost;
+            }
+        }
+    }
+
+    for (const auto& [caps, positions] : std::views::zip(area_caps_, area_positions_)) {
+        std::vector<Cap> open_caps;
+        std::vector<Pos> open_positions;
+        for (const Cap cap : caps) {
+            if (node.pos_of[cap] == NONE) open_caps.push_back(cap);
+        }
+        for (const Pos p : positions) {
+            if (not node.used[p]) open_positions.push_back(p);
+        }
+        const uz n = open_caps.size();
+        if (n == 0) continue;
+        std::vector<fz> costs(n * n);
+        for (uz i = 0; i < n; ++i) {
+            for (uz j = 0; j < n; ++j) {
+                costs[i * n + j] = marginal[open_caps[i] * KEY_COUNT + open_positions[j]];
+            }
+        }
+        bound += Assignment::totalOf(costs, n, Assignment::minimize(costs, n));
+    }
+
+    for (uz p = 0; p < KEY_COUNT; ++p) {
+        row[p] = marginal[next * KEY_COUNT + p];
+    }
+    return bound;
+}
+
+}
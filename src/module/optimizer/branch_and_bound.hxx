@@ -0,0 +1,82 @@
+#ifndef CLUBMOSS_OPTIMIZER_BRANCH_AND_BOUND_HXX
+#define CLUBMOSS_OPTIMIZER_BRANCH_AND_BOUND_HXX
+
+#include <mutex>
+#include <atomic>
+
+#include "control.hxx"
+#include "optimizer_config.hxx"
+#include "../evaluator/evaluator.hxx"
+
+namespace clubmoss::optimizer {
+
+// 分支定界: 逐个为可变键值指定键位, 以各项代价的下界剪枝, 在节点预算内给出可证明的最优解 //
+class BranchAndBound {
+public:
+    BranchAndBound();
+
+    BranchAndBound(BranchAndBound&&) = delete;
+    BranchAndBound(const BranchAndBound&) = delete;
+    BranchAndBound& operator=(BranchAndBound&&) = delete;
+    BranchAndBound& operator=(const BranchAndBound&) = delete;
+
+    auto search() -> fz;
+
+    auto setControl(const Control& control) noexcept -> void;
+
+    [[nodiscard]] auto isCertified() const noexcept -> bool;
+    [[nodiscard]] auto nodes() const noexcept -> uz;
+
+protected:
+    static constexpr Pos NONE{std::numeric_limits<Pos>::max()}; // 尚未指定的键位
+
+    using Positions = std::array<Pos, MAX_KEY_CODE>; // 键值 -> 键位
+
+    // 搜索树的节点, 即一个部分指派 //
+    struct Node {
+        Positions pos_of{}; // 各键值的键位, 尚未指定时为 NONE
+        std::bitset<KEY_COUNT> used{}; // 已被占用的键位
+        uz depth{0}; // 已指定键位的可变键值数
+    };
+
+    std::array<metric::Decomposition, TASK_COUNT> models_{}; // 各项任务的代价分解
+    std::vector<Cap> order_{}; // 分支顺序: 可变键值按其涉及的频率从高到低排列
+    std::array<uz, MAX_KEY_CODE> area_of_{}; // 可变键值 -> 区域编号
+    std::vector<std::vector<Cap>> area_caps_{}; // 各区域的键值
+    std::vector<std::vector<Pos>> area_positions_{}; // 各区域的键位
+    Node root_{}; // 只指定了固定按键的根节点
+    Control control_{};
+
+    std::vector<std::vector<fz>> scratch_{}; // 各线程求下界所用的边际代价表 [键值][键位], 在节点之间复用
+
+    std::vector<Sample> bests_{}; // 损失最小的若干个样本, 按损失升序排列
+    std::atomic<fz> best_loss_{std::numeric_limits<fz>::max()}; // 当前最优损失, 只在持有 mutex_ 时写入
+    std::mutex mutex_;
+
+    std::atomic<uz> nodes_{0}; // 已访问的节点数
+    std::atomic<bool> exhausted_{false}; // 是否已用尽节点预算或被请求停止
+
+    static constexpr uz SPLIT_DEPTH{3}; // 深度小于此值的节点为每个子节点创建一个任务
+    static constexpr uz SEED_STEPS{20'000}; // 生成初始解时每个线程的爬山步数
+    static constexpr uz MAX_BESTS{30}; // 保留的最优样本数
+    static constexpr fz TOLERANCE{1e-9}; // 剪枝时容许的舍入误差
+
+    auto seed(std::vector<Evaluator>& evaluators) -> void;
+    auto branch(const Node& node, std::vector<Evaluator>& evaluators) -> void;
+    auto evaluate(const Node& node, const Evaluator& evl) -> void;
+    auto keep(const Sample& sample) -> void;
+
+    auto lowerBound(const Node& node, std::span<fz> scores, std::span<fz> marginal) const -> fz;
+    auto costBound(
+        const metric::Decomposition& model, const Node& node, Cap next, std::span<fz> row, std::span<fz> marginal
+    ) const -> fz;
+
+private:
+    inline static Config& cfg_ = Config::getInstance();
+
+    friend class clubmoss::Optimizer;
+};
+
+}
+
+#endif //CLUBMOSS_OPTIMIZER_BRANCH_AND_BOUND_HXX
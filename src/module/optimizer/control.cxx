@@ -0,0 +1,92 @@
+#include "control.hxx"
+
+namespace clubmoss::optimizer {
+
+Control::Control(std::stop_token token) noexcept : token_(std::move(token)) {}
+
+/**
+ * @brief 限定墙钟时间: 到达截止时刻后停止搜索.
+ **/
+auto Control::setDeadline(const Clock::time_point deadline) noexcept -> void {
+    start_ = Clock::now();
+    deadline_ = deadline;
+}
+
+/**
+ * @brief 限定评估次数: 从现在起评估的布局数达到 max_evaluations 后停止搜索.
+ **/
+auto Control::setEvaluationBudget(const uint64_t max_evaluations) -> void {
+    evaluations_ = std::make_shared<std::atomic<uint64_t>>(0);
+    start_evaluations_ = 0;
+    max_evaluations_ = max_evaluations;
+}
+
+/**
+ * @brief 记录新评估的布局数; 未设置评估预算时不做任何事.
+ **/
+auto Control::consume(const uint64_t evaluations) const noexcept -> void {
+    if (evaluations_) {
+        evaluations_->fetch_add(evaluations, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief 是否应当停止搜索: 被请求停止, 到达截止时刻, 或评估数用尽.
+ **/
+auto Control::stopRequested() const noexcept -> bool {
+    if (token_.stop_requested()) return true;
+    if (evaluations() >= max_evaluations_) return true;
+    return deadline_ != Clock::time_point::max() and Clock::now() >= deadline_;
+}
+
+/**
+ * @brief 是否限定了墙钟时间或评估次数.
+ **/
+auto Control::isBounded() const noexcept -> bool {
+    return deadline_ != Clock::time_point::max() or evaluations_ != nullptr;
+}
+
+/**
+ * @brief 本份预算已使用的比例, 取时间与评估数中较大的一项.
+ * @return [0, 1] 之间的值; 不限定预算时恒为 0.
+ **/
+auto Control::progress() const noexcept -> fz {
+    fz result = 0.0;
+    if (deadline_ != Clock::time_point::max()) {
+        const fz total = std::chrono::duration<fz>(deadline_ - start_).count();
+        const fz used = std::chrono::duration<fz>(Clock::now() - start_).count();
+        result = total > 0.0 ? used / total : 1.0;
+    }
+    if (evaluations_) {
+        const auto total = static_cast<fz>(max_evaluations_ - start_evaluations_);
+        const auto used = static_cast<fz>(evaluations() - start_evaluations_);
+        result = std::max(result, total > 0.0 ? used / total : 1.0);
+    }
+    return std::clamp(result, 0.0, 1.0);
+}
+
+auto Control::evaluations() const noexcept -> uint64_t {
+    return evaluations_ ? evaluations_->load(std::memory_order_relaxed) : 0;
+}
+
+/**
+ * @brief 将剩余的预算平均分为 parts 份, 返回其中的第一份.
+ * @param parts 份数, 至少为 1.
+ * @return 共享停止请求与评估计数, 但截止时刻与评估上限更早的控制.
+ * @note 各份并行执行时 (例如同一轮的各条退火链), 应按轮次而非份数划分, 因为它们同时消耗时间与评估数.
+ **/
+auto Control::fairShare(const uz parts) const -> Control {
+    Control share = *this;
+    share.start_ = Clock::now();
+    if (deadline_ != Clock::time_point::max()) {
+        const Clock::duration remaining = std::max(deadline_ - share.start_, Clock::duration::zero());
+        share.deadline_ = share.start_ + remaining / static_cast<Clock::rep>(std::max(parts, 1uz));
+    }
+    if (evaluations_) {
+        share.start_evaluations_ = std::min(evaluations(), max_evaluations_);
+        share.max_evaluations_ = share.start_evaluations_ + (max_evaluations_ - share.start_evaluations_) / std::max(parts, 1uz);
+    }
+    return share;
+}
+
+}
@@ -0,0 +1,46 @@
+#ifndef CLUBMOSS_OPTIMIZER_CONTROL_HXX
+#define CLUBMOSS_OPTIMIZER_CONTROL_HXX
+
+#include <atomic>
+#include <chrono>
+#include <stop_token>
+
+#include "../../common/utils.hxx"
+
+namespace clubmoss::optimizer {
+
+// 搜索的外部控制: 各搜索引擎在代, 链或任务单元的边界上检查, 以协作的方式提前结束 //
+// 除停止请求外, 还可以限定墙钟时间与评估次数; 副本之间共享评估计数 //
+class Control final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Control() = default;
+    explicit Control(std::stop_token token) noexcept;
+
+    auto setDeadline(Clock::time_point deadline) noexcept -> void;
+    auto setEvaluationBudget(uint64_t max_evaluations) -> void;
+
+    auto consume(uint64_t evaluations) const noexcept -> void;
+
+    [[nodiscard]] auto stopRequested() const noexcept -> bool;
+    [[nodiscard]] auto isBounded() const noexcept -> bool;
+    [[nodiscard]] auto progress() const noexcept -> fz;
+    [[nodiscard]] auto evaluations() const noexcept -> uint64_t;
+
+    [[nodiscard]] auto fairShare(uz parts) const -> Control;
+
+protected:
+    std::stop_token token_{}; // 默认构造的令牌永远不会被请求停止
+
+    Clock::time_point start_{Clock::now()}; // 本份预算的起始时刻
+    Clock::time_point deadline_{Clock::time_point::max()}; // 截止时刻, 默认不限制
+
+    std::shared_ptr<std::atomic<uint64_t>> evaluations_{}; // 已评估的布局数, 未设置评估预算时为空
+    uint64_t start_evaluations_{0}; // 本份预算开始时的评估数
+    uint64_t max_evaluations_{std::numeric_limits<uint64_t>::max()}; // 评估数达到此值时停止
+};
+
+}
+
+#endif //CLUBMOSS_OPTIMIZER_CONTROL_HXX
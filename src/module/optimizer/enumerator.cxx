@@ -0,0 +1,190 @@
+#include <omp.h>
+#include "enumerator.hxx"
+
+namespace clubmoss::optimizer {
+
+Permutation::Permutation(std::vector<Pos> positions)
+    : positions_(std::move(positions)), counters_(positions_.size(), 0) {}
+
+/**
+ * @brief 生成下一个排列.
+ * @return 需要交换的两个键位; 全部排列都已生成时返回空值, 并重置状态以便从当前排列重新开始.
+ * @note 迭代形式的 Heap 算法, 从任意初始排列出发, 恰好经过 n! - 1 次交换遍历全部排列.
+ **/
+auto Permutation::next() noexcept -> std::optional<std::pair<Pos, Pos>> {
+    const uz n = positions_.size();
+    while (level_ < n) {
+        if (counters_[level_] < level_) {
+            const uz other = level_ % 2 == 0 ? 0 : counters_[level_];
+            const std::pair swapped{positions_[other], positions_[level_]};
+            ++counters_[level_];
+            level_ = 1;
+            return swapped;
+        }
+        counters_[level_] = 0;
+        ++level_;
+    }
+    level_ = 1;
+    return std::nullopt;
+}
+
+auto Permutation::size() const noexcept -> uz {
+    return positions_.size();
+}
+
+/**
+ * @brief 计算当前布局设置下的排列总数, 即各个可变区域大小的阶乘之积.
+ * @return 排列总数, 溢出时返回 uz 的最大值.
+ **/
+auto Enumerator::countPermutations() noexcept -> uz {
+    constexpr uz MAX = std::numeric_limits<uz>::max();
+    uz count = 1;
+    for (const layout::Area& area : layout::Config::getInstance().mutableAreas()) {
+        for (uz k = 2; k <= area.caps().size(); ++k) {
+            if (count > MAX / k) return MAX;
+            count *= k;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief 判断是否应当以穷举代替随机搜索.
+ **/
+auto Enumerator::isFeasible() noexcept -> bool {
+    return cfg_.max_permutations_ != 0 and countPermutations() <= cfg_.max_permutations_;
+}
+
+/**
+ * @brief 并行地遍历全部排列.
+ * @return 最优损失.
+ * @note 遍历时以增量计算求损失, 最后对保留的样本重新完整地评估, 以消除累积的舍入误差.
+ **/
+auto Enumerator::search() -> fz {
+    const uz num_threads = static_cast<uz>(omp_get_max_threads());
+    const Partition part = partition(num_threads);
+    const Layout base = mgr_.create();
+    std::vector<std::vector<Sample>> locals(num_threads);
+
+    spdlog::info(
+        "Enumerating {:d} permutations in {:d} units...",
+        countPermutations(), part.units
+    );
+
+    // 被请求停止时跳过尚未开始的任务单元, 结果不再保证最优
+    #pragma omp parallel for schedule(dynamic) shared(part, base, locals, control_) firstprivate(evl_) default (none)
+    for (uz unit = 0; unit < part.units; ++unit) {
+        if (control_.stopRequested()) continue;
+        control_.consume(enumerate(part, unit, base, evl_, locals[static_cast<uz>(omp_get_thread_num())]));
+    }
+
+    bests_.clear();
+    for (std::vector<Sample>& local : locals) {
+        for (Sample& sample : local) {
+            evl_.analyze(sample);
+            keep(bests_, sample);
+        }
+    }
+    return bests_.empty() ? std::numeric_limits<fz>::max() : bests_.front().getLoss();
+}
+
+auto Enumerator::setControl(const Control& control) noexcept -> void {
+    control_ = control;
+}
+
+/**
+ * @brief 选取最大的可变区域, 并确定需要固定的键位数, 使任务单元数足以在线程间均衡负载.
+ * @param num_threads 线程数.
+ **/
+auto Enumerator::partition(const uz num_threads) -> Partition {
+    const std::vector<layout::Area>& areas = layout::Config::getInstance().mutableAreas();
+    const auto largest = std::ranges::max_element(
+        areas, {}, [](const layout::Area& area) { return area.caps().size(); }
+    );
+
+    Partition part;
+    part.area = static_cast<uz>(std::distance(areas.begin(), largest));
+    part.caps.assign(largest->caps().begin(), largest->caps().end());
+    part.positions.assign(largest->positions().begin(), largest->positions().end());
+    std::ranges::sort(part.positions);
+
+    const uz n = part.caps.size();
+    while (part.depth + 1 < n and part.units < UNITS_PER_THREAD * num_threads) {
+        part.units *= n - part.depth;
+        ++part.depth;
+    }
+    return part;
+}
+
+/**
+ * @brief 遍历一个任务单元内的全部排列.
+ * @param part 排列空间的划分.
+ * @param unit 任务单元的编号, 以混合进制 (n, n - 1, ...) 编码最大区域前 depth 个键位上的键值.
+ * @param base 初始布局, 提供固定按键的位置.
+ * @param evl 当前线程的评估器.
+ * @param bests 当前线程找到的最优样本, 将被更新.
+ * @return 评估的排列数.
+ **/
+auto Enumerator::enumerate(
+    const Partition& part, const uz unit, const Layout& base,
+    const Evaluator& evl, std::vector<Sample>& bests
+) -> uz {
+    Sample sample(base);
+    std::vector<Cap> remaining = part.caps;
+    uz code = unit;
+    for (uz k = 0; k < part.depth; ++k) {
+        const uz radix = part.caps.size() - k;
+        const auto it = remaining.begin() + static_cast<std::ptrdiff_t>(code % radix);
+        sample.setKey(*it, part.positions[k]);
+        remaining.erase(it);
+        code /= radix;
+    }
+    for (const auto& [cap, pos] : std::views::zip(remaining, part.positions | std::views::drop(part.depth))) {
+        sample.setKey(cap, pos);
+    }
+
+    // 第一个排列器负责最大区域中未固定的键位, 其后依次是其余的区域, 它们像里程表一样逐级进位
+    std::vector<Permutation> perms;
+    perms.emplace_back(std::vector(part.positions.begin() + static_cast<std::ptrdiff_t>(part.depth), part.positions.end()));
+    for (const auto& [i, area] : layout::Config::getInstance().mutableAreas() | std::views::enumerate) {
+        if (static_cast<uz>(i) != part.area) {
+            perms.emplace_back(std::vector(area.positions().begin(), area.positions().end()));
+        }
+    }
+
+    evl.analyze(sample);
+    keep(bests, sample);
+    uz evaluations = 1;
+    while (true) {
+        std::optional<std::pair<Pos, Pos>> swapped;
+        for (Permutation& perm : perms) {
+            if ((swapped = perm.next())) break;
+        }
+        if (not swapped) break;
+
+        const auto [pos1, pos2] = *swapped;
+        sample.swap2Keys(pos1, pos2);
+        evl.update(sample, sample, pos1, pos2);
+        ++evaluations;
+        if (bests.size() < MAX_BESTS or sample.getLoss() < bests.back().getLoss()) {
+            keep(bests, sample);
+        }
+    }
+    return evaluations;
+}
+
+/**
+ * @brief 将样本按损失升序插入 bests, 并只保留前 MAX_BESTS 个.
+ **/
+auto Enumerator::keep(std::vector<Sample>& bests, const Sample& sample) -> void {
+    const auto it = std::ranges::upper_bound(
+        bests, sample.getLoss(), {}, [](const Sample& s) { return s.getLoss(); }
+    );
+    if (static_cast<uz>(it - bests.begin()) >= MAX_BESTS) return;
+    bests.insert(it, sample);
+    if (bests.size() > MAX_BESTS) {
+        bests.pop_back();
+    }
+}
+
+}
@@ -0,0 +1,77 @@
+#ifndef CLUBMOSS_OPTIMIZER_ENUMERATOR_HXX
+#define CLUBMOSS_OPTIMIZER_ENUMERATOR_HXX
+
+#include "control.hxx"
+#include "optimizer_config.hxx"
+#include "../evaluator/evaluator.hxx"
+
+namespace clubmoss::optimizer {
+
+// 以 Heap 算法逐次交换一对键位, 遍历一组键位上的全部排列 //
+class Permutation {
+public:
+    explicit Permutation(std::vector<Pos> positions);
+
+    auto next() noexcept -> std::optional<std::pair<Pos, Pos>>;
+
+    [[nodiscard]] auto size() const noexcept -> uz;
+
+protected:
+    std::vector<Pos> positions_; // 参与排列的键位
+    std::vector<uz> counters_; // 各层的循环计数器
+    uz level_{1}; // 当前所在的层
+};
+
+// 穷举搜索: 可变区域足够小时, 并行地遍历全部排列, 给出可证明的最优解 //
+class Enumerator {
+public:
+    Enumerator() = default;
+
+    Enumerator(Enumerator&&) = delete;
+    Enumerator(const Enumerator&) = delete;
+    Enumerator& operator=(Enumerator&&) = delete;
+    Enumerator& operator=(const Enumerator&) = delete;
+
+    auto search() -> fz;
+
+    auto setControl(const Control& control) noexcept -> void;
+
+    static auto countPermutations() noexcept -> uz;
+    static auto isFeasible() noexcept -> bool;
+
+protected:
+    layout::Manager mgr_{};
+    Evaluator evl_{};
+    Control control_{};
+
+    std::vector<Sample> bests_{}; // 损失最小的若干个样本, 按损失升序排列
+
+    static constexpr uz MAX_BESTS{30}; // 保留的最优样本数
+    static constexpr uz UNITS_PER_THREAD{8}; // 每个线程平均分得的任务单元数
+
+    // 将排列空间划分为若干个任务单元: 固定最大区域的前 depth 个键位上的键值 //
+    struct Partition {
+        uz area{0}; // 最大区域的编号
+        std::vector<Cap> caps; // 最大区域的键值
+        std::vector<Pos> positions; // 最大区域的键位
+        uz depth{0}; // 固定的键位数
+        uz units{1}; // 任务单元数
+    };
+
+    static auto partition(uz num_threads) -> Partition;
+
+    static auto enumerate(
+        const Partition& part, uz unit, const Layout& base, const Evaluator& evl, std::vector<Sample>& bests
+    ) -> uz;
+
+    static auto keep(std::vector<Sample>& bests, const Sample& sample) -> void;
+
+private:
+    inline static Config& cfg_ = Config::getInstance();
+
+    friend class clubmoss::Optimizer;
+};
+
+}
+
+#endif //CLUBMOSS_OPTIMIZER_ENUMERATOR_HXX
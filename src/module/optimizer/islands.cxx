@@ -0,0 +1,127 @@
+#include <omp.h>
+#include "islands.hxx"
+
+namespace clubmoss::optimizer {
+
+Mailbox::Mailbox(const uz capacity, const Layout& layout)
+    : migrants_(capacity, layout) {}
+
+/**
+ * @brief 将 sender 中排名最高的布局放入信箱.
+ * @param sender 发送方样本池, 只能由一个线程调用.
+ * @return 是否投递成功, 信箱中仍有尚未送达的布局时放弃本次投递.
+ **/
+auto Mailbox::post(const Pool& sender) noexcept -> bool {
+    if (full_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    sender.emigrate(migrants_);
+    full_.store(true, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief 将信箱中的布局送达 receiver.
+ * @param receiver 接收方样本池, 只能由一个线程调用.
+ * @return 是否有布局送达.
+ **/
+auto Mailbox::deliver(Pool& receiver) noexcept -> bool {
+    if (not full_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    receiver.immigrate(migrants_);
+    full_.store(false, std::memory_order_release);
+    return true;
+}
+
+Islands::Islands() {
+    const uz count = cfg_.num_islands_ != 0 ? cfg_.num_islands_ : static_cast<uz>(omp_get_max_threads());
+    layout::Manager mgr;
+    for (uz i = 0; i < count; ++i) {
+        pools_.emplace_back(std::make_unique<Pool>());
+        pools_.back()->setSize(cfg_.island_pool_size_);
+        mailboxes_.emplace_back(std::make_unique<Mailbox>(cfg_.num_migrants_, mgr.create()));
+    }
+}
+
+auto Islands::size() const noexcept -> uz {
+    return pools_.size();
+}
+
+auto Islands::setControl(const Control& control) noexcept -> void {
+    control_ = control;
+    for (const std::unique_ptr<Pool>& pool : pools_) {
+        pool->setControl(control);
+    }
+}
+
+auto Islands::setSeeds(const std::vector<Layout>& seeds) -> void {
+    for (const std::unique_ptr<Pool>& pool : pools_) {
+        pool->setSeeds(seeds);
+    }
+}
+
+/**
+ * @brief 在各自的线程上并发运行所有岛屿, 直到轮次用尽或全局停滞.
+ * @param max_rounds 所有岛屿合计的最大轮次.
+ * @param max_stagnation_rounds 全局最优损失未改进的最大轮次.
+ * @param on_round 每一轮搜索结束时的回调, 在互斥锁内串行调用.
+ * @return 全局最优损失.
+ **/
+auto Islands::search(const uz max_rounds, const uz max_stagnation_rounds, const RoundCallback& on_round) -> fz {
+    next_round_ = 0;
+    stopped_ = false;
+    best_loss_ = std::numeric_limits<fz>::max();
+    best_round_ = 0;
+
+    // 每个岛屿独占一个线程, 样本池内部的并行区域将由该线程串行执行
+    const int max_active_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(1);
+
+    const int num_threads = static_cast<int>(pools_.size());
+    #pragma omp parallel num_threads(num_threads) default(shared)
+    {
+        const uz island = static_cast<uz>(omp_get_thread_num());
+        runIsland(island, max_rounds, max_stagnation_rounds, on_round);
+    }
+
+    omp_set_max_active_levels(max_active_levels);
+    return best_loss_;
+}
+
+auto Islands::runIsland(
+    const uz island, const uz max_rounds,
+    const uz max_stagnation_rounds, const RoundCallback& on_round
+) -> void {
+    Pool& pool = *pools_[island];
+    Mailbox& inbox = *mailboxes_[island];
+    Mailbox& outbox = *mailboxes_[(island + 1) % pools_.size()];
+
+    while (not stopped_.load(std::memory_order_relaxed) and not control_.stopRequested()) {
+        const uz round = next_round_.fetch_add(1, std::memory_order_relaxed);
+        if (round >= max_rounds) {
+            break;
+        }
+
+        pool.start();
+        while (pool.step()) {
+            if (pool.curr_epoch_ % cfg_.migration_interval_ == 0) {
+                outbox.post(pool);
+                inbox.deliver(pool);
+            }
+        }
+        const fz loss = pool.finish();
+
+        std::lock_guard lock(mutex_);
+        if (loss < best_loss_.load(std::memory_order_relaxed)) {
+            best_loss_.store(loss, std::memory_order_relaxed);
+            best_round_ = round;
+        }
+        on_round(pool, island, round, loss, best_loss_.load(std::memory_order_relaxed));
+        if (round >= best_round_ + max_stagnation_rounds) {
+            stopped_.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+}
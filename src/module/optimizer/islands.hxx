@@ -0,0 +1,68 @@
+#ifndef CLUBMOSS_OPTIMIZER_ISLANDS_HXX
+#define CLUBMOSS_OPTIMIZER_ISLANDS_HXX
+
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+#include "o_pool.hxx"
+#include "optimizer_config.hxx"
+
+namespace clubmoss::optimizer {
+
+// 在相邻岛屿之间传递迁移样本的信箱, 单生产者单消费者, 无锁 //
+class alignas(64) Mailbox {
+public:
+    Mailbox(uz capacity, const Layout& layout);
+
+    auto post(const Pool& sender) noexcept -> bool;
+    auto deliver(Pool& receiver) noexcept -> bool;
+
+protected:
+    std::vector<Layout> migrants_; // 待迁移的布局
+    std::atomic<bool> full_{false}; // 信箱中是否有尚未送达的布局
+};
+
+// 岛屿模型: 多个样本池在各自的线程上并发搜索, 并沿环形拓扑周期性地迁移最优样本 //
+class Islands {
+public:
+    // 每一轮搜索结束时的回调, 参数依次为: 样本池, 岛屿编号, 轮次, 本轮损失, 全局最优损失
+    using RoundCallback = std::function<void(const Pool&, uz, uz, fz, fz)>;
+
+    Islands();
+
+    Islands(Islands&&) = delete;
+    Islands(const Islands&) = delete;
+    Islands& operator=(Islands&&) = delete;
+    Islands& operator=(const Islands&) = delete;
+
+    auto search(uz max_rounds, uz max_stagnation_rounds, const RoundCallback& on_round) -> fz;
+
+    [[nodiscard]] auto size() const noexcept -> uz;
+
+    auto setControl(const Control& control) noexcept -> void;
+    auto setSeeds(const std::vector<Layout>& seeds) -> void;
+
+protected:
+    std::vector<std::unique_ptr<Pool>> pools_{};
+    std::vector<std::unique_ptr<Mailbox>> mailboxes_{};
+
+    Control control_{};
+
+    std::atomic<uz> next_round_{0}; // 下一个待分配的轮次
+    std::atomic<bool> stopped_{false}; // 是否已经全局停滞
+
+    // 全局最优记录, 只在持有 mutex_ 时写入
+    std::atomic<fz> best_loss_{std::numeric_limits<fz>::max()};
+    uz best_round_{0};
+    std::mutex mutex_;
+
+    auto runIsland(uz island, uz max_rounds, uz max_stagnation_rounds, const RoundCallback& on_round) -> void;
+
+private:
+    inline static Config& cfg_ = Config::getInstance();
+};
+
+}
+
+#endif //CLUBMOSS_OPTIMIZER_ISLANDS_HXX
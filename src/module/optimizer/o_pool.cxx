@@ -4,83 +4,209 @@
 namespace clubmoss::optimizer {
 
 Pool::Pool() {
-    samples_.reserve(4800);
-    for (uz i = 0; i < size_; ++i) {
-        samples_.emplace_back(std::make_unique<Sample>(mgr_.create()));
-    }
+    population_.resize(size_, mgr_.create());
 }
 
 auto Pool::search() noexcept -> fz {
+    start();
+    while (step()) {}
+    return finish();
+}
+
+/**
+ * @brief 重新初始化并评估所有样本, 开始新一轮搜索.
+ **/
+auto Pool::start() noexcept -> void {
     best_loss_ = std::numeric_limits<fz>::max();
     curr_epoch_ = best_epoch_ = 0;
 
+    ++runs_;
+    run_start_ = epoch_start_ = telemetry::Telemetry::Clock::now();
+    run_counters_.reset();
+
     reinitAndEvaluateSamples();
+    charge(size_);
     sortSamples();
+}
 
-    while (curr_epoch_ < MAX_EPOCHS) {
-        if (const fz loss = samples_.front()->getLoss(); loss < best_loss_) {
-            best_epoch_ = curr_epoch_;
-            best_loss_ = loss;
-        }
-        stagnation_epochs_ = curr_epoch_ - best_epoch_;
-        if (stagnation_epochs_ >= max_stagnation_epochs_) {
-            break;
-        }
-        ++curr_epoch_;
-
-        if (curr_epoch_ % 5 == 0) {
-            unique();
-        }
+/**
+ * @brief 推进一代: 记录最优损失, 并由幸存者产生新的样本.
+ * @return 是否应当继续搜索, 达到最大代数, 停滞, 被请求停止或预算用尽时返回 false.
+ **/
+auto Pool::step() noexcept -> bool {
+    if (curr_epoch_ >= MAX_EPOCHS) {
+        return false;
+    }
+    if (const fz loss = population_.loss(population_.indexOf(0)); loss < best_loss_) {
+        best_epoch_ = curr_epoch_;
+        best_loss_ = loss;
+    }
+    if (control_.stopRequested()) {
+        return false;
+    }
+    stagnation_epochs_ = curr_epoch_ - best_epoch_;
+    if (stagnation_epochs_ >= max_stagnation_epochs_) {
+        return false;
+    }
+    ++curr_epoch_;
 
-        updateAndEvaluateSamples();
-        sortSamples();
+    using telemetry::Probe, telemetry::Telemetry;
+    if (curr_epoch_ % 5 == 0) {
+        Telemetry::time(epoch_counters_, Probe::Unique, [this] -> void { unique(); });
     }
 
-    updateMse();
+    updateAndEvaluateSamples();
+    charge(size_ - half_);
+    Telemetry::time(epoch_counters_, Probe::Sort, [this] -> void { selectSamples(); });
+    report(telemetry::ReportKind::Epoch);
+    return true;
+}
+
+/**
+ * @brief 结束本轮搜索, 更新停滞阈值.
+ * @return 本轮搜索的最优损失.
+ **/
+auto Pool::finish() noexcept -> fz {
+    // 提前结束的搜索不能反映收敛所需的代数, 因此不参与更新停滞阈值
+    if (not control_.stopRequested()) {
+        updateMse();
+    }
     spdlog::debug(
         "Epochs: {: >3d} - {: >3d} + {: >3d}, stagnation = {:7.3f}",
         curr_epoch_, best_epoch_, stagnation_epochs_,
         fz(stagnation_epochs_) / fz(curr_epoch_) * 100.0
     );
+    report(telemetry::ReportKind::Pool);
 
     return best_loss_;
 }
 
+/**
+ * @brief 复制排名最高的若干个布局, 用于向其他样本池迁移.
+ * @param migrants 输出的布局, 其长度决定了复制的数量.
+ **/
+auto Pool::emigrate(const std::span<Layout> migrants) const noexcept -> void {
+    assert(migrants.size() <= half_);
+    for (uz rank = 0; rank < migrants.size(); ++rank) {
+        migrants[rank] = population_.layout(population_.indexOf(rank));
+    }
+}
+
+/**
+ * @brief 接收来自其他样本池的布局, 替换幸存者中排名最低的样本.
+ * @param migrants 迁入的布局.
+ **/
+auto Pool::immigrate(const std::span<const Layout> migrants) noexcept -> void {
+    assert(migrants.size() <= half_);
+    for (uz k = 0; k < migrants.size(); ++k) {
+        const uz i = population_.indexOf(half_ - 1 - k);
+        population_.layout(i) = migrants[k];
+        evl_.analyze(population_, i);
+    }
+    charge(migrants.size());
+    sortSamples();
+}
+
 auto Pool::reinitAndEvaluateSamples() noexcept -> void {
-    #pragma omp parallel for schedule(guided) shared(samples_) firstprivate(mgr_, evl_) lastprivate(mgr_, evl_) default (none)
+    using telemetry::Probe, telemetry::Telemetry;
+    const uz warm = seeds_.empty() ? 0 : std::min(size_, static_cast<uz>(cfg_.warm_start_ratio_ * static_cast<fz>(size_)));
+    workers_.prepare();
+    #pragma omp parallel for schedule(guided) shared(population_, workers_, warm) default (none)
     for (uz i = 0; i < size_; ++i) {
-        mgr_.reinit(*samples_[i]);
-        evl_.analyze(*samples_[i]);
+        Worker& worker = workers_.local();
+        Telemetry::time(worker.counters, Probe::Mutate, [&] -> void {
+            if (i < warm) {
+                warmStart(worker.mgr, i);
+            } else {
+                worker.mgr.reinit(population_.layout(i));
+            }
+        });
+        Telemetry::time(worker.counters, Probe::Analyze, [&] -> void { worker.evl.analyze(population_, i); });
+    }
+}
+
+/**
+ * @brief 以已知布局或其邻居初始化第 i 个样本.
+ * @param mgr 当前线程的布局管理器.
+ * @param i 样本的下标; 前 seeds_.size() 个样本即已知布局, 此后的邻居与已知布局之间的交换次数在 [1, max_distance] 中循环.
+ **/
+auto Pool::warmStart(layout::Manager& mgr, const uz i) noexcept -> void {
+    const uz n = seeds_.size();
+    const uz distance = i < n ? 0 : 1 + (i - n) / n % cfg_.warm_start_max_distance_;
+    Layout& layout = population_.layout(i);
+    layout = seeds_[i % n];
+    for (uz k = 0; k < distance; ++k) {
+        mgr.mutate(layout, layout);
     }
 }
 
 auto Pool::updateAndEvaluateSamples() noexcept -> void {
-    #pragma omp parallel for schedule(guided) shared(samples_) firstprivate(mgr_, evl_) lastprivate(mgr_, evl_) default (none)
+    using telemetry::Probe, telemetry::Telemetry;
+    workers_.prepare();
+    #pragma omp parallel for schedule(guided) shared(population_, workers_) default (none)
     for (uz i = half_; i < size_; ++i) {
-        mgr_.mutate(*samples_[i], *samples_[i - half_]);
-        evl_.analyze(*samples_[i]);
+        Worker& worker = workers_.local();
+        const uz parent = population_.indexOf(i - half_);
+        const uz child = population_.indexOf(i);
+        const auto [pos1, pos2] = Telemetry::time(worker.counters, Probe::Mutate, [&] -> std::pair<Pos, Pos> {
+            return worker.mgr.mutate(population_.layout(child), population_.layout(parent));
+        });
+        Telemetry::time(worker.counters, Probe::Analyze, [&] -> void {
+            worker.evl.update(population_, child, parent, pos1, pos2);
+        });
     }
 }
 
 auto Pool::sortSamples() -> void {
-    std::sort(
-        &samples_.front(), &samples_[size_ - 1],
-        [](const std::unique_ptr<Sample>& lhs, const std::unique_ptr<Sample>& rhs) {
-            return lhs->getLoss() < rhs->getLoss();
-        }
-    );
+    population_.sort(std::less{});
 }
 
+auto Pool::selectSamples() -> void {
+    population_.select(half_, std::less{});
+}
+
+/**
+ * @brief 消除幸存者中的重复样本: 每组重复样本只保留排名最高的一个, 其余重新初始化.
+ * @note 按 (哈希值, 排名) 排序后, 重复样本彼此相邻, 因此只需比较相邻的样本.
+ **/
 auto Pool::unique() -> void {
-    for (uz i = 0; i < half_ - 1; ++i) {
-        if (samples_[i].get() == samples_[i + 1].get()) {
-            mgr_.reinit(*samples_[i]);
-            evl_.analyze(*samples_[i]);
+    std::vector<std::pair<Hash, uz>> keys(half_);
+    #pragma omp parallel for schedule(static) shared(population_, keys) default (none)
+    for (uz rank = 0; rank < half_; ++rank) {
+        keys[rank] = {population_.layout(population_.indexOf(rank)).getHash(), rank};
+    }
+    std::ranges::sort(keys);
+
+    std::vector<uz> duplicates;
+    for (uz k = 1; k < keys.size(); ++k) {
+        if (keys[k].first != keys[k - 1].first) continue;
+        const uz curr = population_.indexOf(keys[k].second);
+        const uz prev = population_.indexOf(keys[k - 1].second);
+        if (population_.layout(curr) == population_.layout(prev)) {
+            duplicates.push_back(curr);
         }
     }
+    if (duplicates.empty()) return;
+
+    workers_.prepare();
+    #pragma omp parallel for schedule(guided) shared(population_, duplicates, workers_) default (none)
+    for (uz k = 0; k < duplicates.size(); ++k) {
+        Worker& worker = workers_.local();
+        worker.mgr.reinit(population_.layout(duplicates[k]));
+        worker.evl.analyze(population_, duplicates[k]);
+    }
+    charge(duplicates.size());
     sortSamples();
 }
 
+/**
+ * @brief 记录新评估的布局数: 计入评估预算, 以及本代的遥测计数.
+ **/
+auto Pool::charge(const uz evaluations) noexcept -> void {
+    control_.consume(evaluations);
+    epoch_counters_.evaluations += evaluations;
+}
+
 auto Pool::updateMse() -> void {
     const uz new_value = static_cast<uz>(
         static_cast<fz>(max_stagnation_epochs_) * ALPHA +
@@ -89,10 +215,93 @@ auto Pool::updateMse() -> void {
     max_stagnation_epochs_ = std::clamp(new_value, 30uz, 300uz);
 }
 
+/**
+ * @brief 在启用遥测时发送本代或本轮的统计数据.
+ * @param kind 一代结束时为 Epoch, 一轮结束时为 Pool.
+ **/
+auto Pool::report(const telemetry::ReportKind kind) -> void {
+    using telemetry::Telemetry;
+    if (not Telemetry::enabled()) return;
+
+    const Telemetry::Clock::time_point now = Telemetry::Clock::now();
+    telemetry::Report report{
+        .kind = kind, .pool = runs_, .epoch = curr_epoch_,
+        .stagnation_epochs = curr_epoch_ - best_epoch_, .best_loss = best_loss_,
+    };
+    if (kind == +telemetry::ReportKind::Epoch) {
+        workers_.collect(epoch_counters_);
+        report.seconds = std::chrono::duration<fz>(now - epoch_start_).count();
+        report.counters = epoch_counters_;
+        run_counters_.merge(epoch_counters_);
+        epoch_counters_.reset();
+        epoch_start_ = now;
+    } else {
+        report.seconds = std::chrono::duration<fz>(now - run_start_).count();
+        report.counters = run_counters_;
+    }
+    Telemetry::emit(report);
+}
+
+auto Pool::setControl(const Control& control) noexcept -> void {
+    control_ = control;
+}
+
+/**
+ * @brief 设置热启动所用的已知布局; 此后每轮搜索开始时, 以它们及其邻居初始化一部分样本.
+ * @param seeds 已知布局, 必须与当前布局设置兼容; 为空时全部样本随机初始化.
+ **/
+auto Pool::setSeeds(std::vector<Layout> seeds) -> void {
+    seeds_ = std::move(seeds);
+}
+
 auto Pool::setSize(const uz size) noexcept -> void {
     assert(size % 2 == 0);
     half_ = size / 2;
     size_ = size;
+    if (population_.size() != size_) {
+        population_.resize(size_, mgr_.create());
+    }
+}
+
+/**
+ * @brief 将搜索进度写入检查点: 代数计数器, 停滞阈值, 以及按排名排列的全部布局.
+ * @param writer 检查点写入器.
+ * @note 损失与代价可由布局重新计算, 因此不写入检查点.
+ **/
+auto Pool::save(Checkpoint::Writer& writer) const -> void {
+    writer.write(size_).write(best_loss_)
+          .write(curr_epoch_).write(best_epoch_)
+          .write(stagnation_epochs_).write(max_stagnation_epochs_);
+    for (uz rank = 0; rank < size_; ++rank) {
+        writer.write(population_.layout(population_.indexOf(rank)));
+    }
+}
+
+/**
+ * @brief 从检查点恢复搜索进度, 并重新评估所有样本.
+ * @param reader 检查点读取器.
+ * @throws FatalError 如果检查点内容不完整或不合法.
+ **/
+auto Pool::load(Checkpoint::Reader& reader) -> void {
+    uz size{};
+    reader.read(size);
+    if (size < 2 or size % 2 != 0) {
+        throw FatalError(std::format("Illegal pool size {:d} in checkpoint", size));
+    }
+    setSize(size);
+    reader.read(best_loss_)
+          .read(curr_epoch_).read(best_epoch_)
+          .read(stagnation_epochs_).read(max_stagnation_epochs_);
+    for (uz i = 0; i < size_; ++i) {
+        reader.read(population_.layout(i));
+    }
+
+    workers_.prepare();
+    #pragma omp parallel for schedule(guided) shared(population_, workers_) default (none)
+    for (uz i = 0; i < size_; ++i) {
+        workers_.local().evl.analyze(population_, i);
+    }
+    sortSamples();
 }
 
 }
@@ -1,7 +1,10 @@
 #ifndef CLUBMOSS_OPTIMIZER_POOL_HXX
 #define CLUBMOSS_OPTIMIZER_POOL_HXX
 
-#include "../evaluator/evaluator.hxx"
+#include "control.hxx"
+#include "workers.hxx"
+#include "optimizer_config.hxx"
+#include "../checkpoint/checkpoint.hxx"
 
 namespace clubmoss {
 class Optimizer;
@@ -20,12 +23,27 @@ public:
 
     auto search() noexcept -> fz;
 
+    auto start() noexcept -> void;
+    auto step() noexcept -> bool;
+    auto finish() noexcept -> fz;
+
+    auto emigrate(std::span<Layout> migrants) const noexcept -> void;
+    auto immigrate(std::span<const Layout> migrants) noexcept -> void;
+
     auto setSize(uz size) noexcept -> void;
+    auto setControl(const Control& control) noexcept -> void;
+    auto setSeeds(std::vector<Layout> seeds) -> void;
+
+    auto save(Checkpoint::Writer& writer) const -> void;
+    auto load(Checkpoint::Reader& reader) -> void;
 
 protected:
-    std::vector<std::unique_ptr<Sample>> samples_{};
-    layout::Manager mgr_{};
-    Evaluator evl_{};
+    Population population_{};
+    layout::Manager mgr_{}; // 供串行代码使用
+    Evaluator evl_{}; // 供串行代码使用
+    Workers workers_{}; // 供并行区域使用, 在各代与各样本池之间复用
+    Control control_{};
+    std::vector<Layout> seeds_{}; // 热启动所用的已知布局
 
     uz size_{4800};
     uz half_{2400};
@@ -38,18 +56,32 @@ protected:
     uz stagnation_epochs_{0};
     uz max_stagnation_epochs_{250};
 
+    uz runs_{0}; // 已开始的轮次
+    telemetry::Counters epoch_counters_{}; // 本代串行部分的计数, 报告时并入各线程的计数
+    telemetry::Counters run_counters_{}; // 本轮的累计计数
+    telemetry::Telemetry::Clock::time_point run_start_{}; // 本轮的开始时间
+    telemetry::Telemetry::Clock::time_point epoch_start_{}; // 本代的开始时间
+
     static constexpr uz MAX_EPOCHS{1000};
     static constexpr fz ALPHA{0.5};
 
     auto reinitAndEvaluateSamples() noexcept -> void;
+    auto warmStart(layout::Manager& mgr, uz i) noexcept -> void;
     auto updateAndEvaluateSamples() noexcept -> void;
     auto sortSamples() -> void;
+    auto selectSamples() -> void;
     auto unique() -> void;
+    auto charge(uz evaluations) noexcept -> void;
 
     auto updateMse() -> void;
 
+    auto report(telemetry::ReportKind kind) -> void;
+
 private:
+    inline static Config& cfg_ = Config::getInstance();
+
     friend class clubmoss::Optimizer;
+    friend class Islands;
 };
 
 }
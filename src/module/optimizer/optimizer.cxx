@@ -3,14 +3,142 @@
 namespace clubmoss {
 
 auto Optimizer::search() -> void {
+    spdlog::info("Optimizing...");
+    const optimizer::Control::Clock::time_point start = optimizer::Control::Clock::now();
+    applyBudget();
+
+    // 可变区域足够小时, 穷举比任何搜索模式都更快, 而且结果可证明是最优的
+    if (optimizer::Enumerator::isFeasible()) {
+        searchByEnumeration();
+    } else {
+        switch (cfg_.mode_._value) {
+        case optimizer::SearchMode::Annealing:
+            searchByAnnealing();
+            break;
+        case optimizer::SearchMode::Islands:
+            searchByIslands();
+            break;
+        case optimizer::SearchMode::BranchAndBound:
+            searchByBranchAndBound();
+            break;
+        case optimizer::SearchMode::Pool:
+        default:
+            searchByPool();
+            break;
+        }
+    }
+
+    spdlog::info(
+        "Optimization complete. Found {:d} candidate solutions.",
+        best_samples_.size()
+    );
+    if (control_.isBounded()) {
+        spdlog::info(
+            "Used {:.1f} seconds and {:d} evaluations of the budget.",
+            std::chrono::duration<fz>(optimizer::Control::Clock::now() - start).count(), control_.evaluations()
+        );
+    }
+    saveResults();
+    saveReferenceLoss();
+    saveBaselines();
+}
+
+/**
+ * @brief 设置外部控制; 被请求停止时, 搜索在下一个检查点提前结束, 并照常保存已找到的结果.
+ **/
+auto Optimizer::setControl(const optimizer::Control& control) noexcept -> void {
+    control_ = control;
+}
+
+auto Optimizer::setProgressCallback(ProgressCallback callback) -> void {
+    on_progress_ = std::move(callback);
+}
+
+/**
+ * @brief 按搜索设置中的 [budget] 限定墙钟时间与评估次数; 预算用尽时, 搜索照常保存已找到的最优结果.
+ **/
+auto Optimizer::applyBudget() -> void {
+    if (cfg_.budget_seconds_ > 0) {
+        control_.setDeadline(optimizer::Control::Clock::now() + std::chrono::seconds(cfg_.budget_seconds_));
+    }
+    if (cfg_.budget_evaluations_ > 0) {
+        control_.setEvaluationBudget(cfg_.budget_evaluations_);
+    }
+}
+
+/**
+ * @brief 收集热启动所用的已知布局: 上次保存的结果与兼容的基准布局.
+ * @return 与当前布局设置兼容且互不相同的布局; 未启用热启动时为空.
+ * @note 上次的结果可能是在不同的布局设置下得到的, 因此同样需要检查兼容性.
+ **/
+auto Optimizer::loadSeeds() const -> std::vector<Layout> {
+    std::vector<Layout> seeds;
+    if (not cfg_.warm_start_enabled_) return seeds;
+
+    std::unordered_set<Hash> hashes;
+    const auto add = [&](const Layout& layout) -> void {
+        if (pool_.mgr_.canManage(layout) and hashes.insert(layout.getHash()).second) {
+            seeds.push_back(layout);
+        }
+    };
+    if (cfg_.warm_start_results_) {
+        for (uz i = 1; i <= MAX_RESULTS; ++i) {
+            const std::string path = Utils::absPath(std::format("cache/result/result_{}.toml", i));
+            if (not std::filesystem::exists(path)) break;
+            try {
+                add(Layout(toml::parse(path).at("keys").as_string()));
+            } catch (const std::exception& e) {
+                spdlog::warn("Ignored previous result \"{:s}\": {:s}", path, e.what());
+            }
+        }
+    }
+    if (cfg_.warm_start_baselines_) {
+        for (const layout::baselines::Baseline& baseline : layout::baselines::ALL) {
+            add(baseline);
+        }
+    }
+    spdlog::info("Warm start from {:d} known layouts.", seeds.size());
+    return seeds;
+}
+
+auto Optimizer::searchByPool() -> void {
     pool_.setSize(Resources::STATUS.at("pool_size").as_integer());
+    pool_.setSeeds(loadSeeds());
     best_loss_ = std::numeric_limits<fz>::max();
     curr_pool_ = best_pool_ = 0;
 
-    spdlog::info("Optimizing...");
+    bool in_pool = loadCheckpoint();
 
     while (curr_pool_ < MAX_POOLS) {
-        const fz curr_loss = pool_.search();
+        if (control_.stopRequested()) {
+            saveCheckpoint(in_pool);
+            return;
+        }
+        // 限定预算时, 前 min_pools 个样本池平分剩余的预算, 之后的样本池可以使用全部剩余的预算
+        const uz parts = curr_pool_ < cfg_.budget_min_pools_ ? cfg_.budget_min_pools_ - curr_pool_ : 1;
+        pool_.setControl(control_.isBounded() ? control_.fairShare(parts) : control_);
+        if (not in_pool) {
+            pool_.start();
+        }
+        in_pool = false;
+        while (pool_.step()) {
+            publish(pool_);
+            if (pool_.curr_epoch_ % cfg_.checkpoint_epochs_ == 0) {
+                saveCheckpoint(true);
+            }
+        }
+        // 被请求停止或预算用尽时保留检查点, 以便之后从当前样本池继续搜索
+        if (control_.stopRequested()) {
+            copyBestSamples(pool_);
+            best_loss_ = std::min(best_loss_, pool_.population_.loss(pool_.population_.indexOf(0)));
+            saveCheckpoint(true);
+            spdlog::info(
+                "[Pool {: >2d}]: stopped at epoch {: >3d}, best loss so far is {:8.5f}",
+                curr_pool_, pool_.curr_epoch_, best_loss_
+            );
+            return;
+        }
+        const fz curr_loss = pool_.finish();
         if (curr_loss < best_loss_) {
             best_pool_ = curr_pool_;
             best_loss_ = curr_loss;
@@ -20,28 +148,185 @@ auto Optimizer::search() -> void {
             "best loss so far is {:8.5f} of Pool {: >2d}",
             curr_pool_, curr_loss, best_loss_, best_pool_
         );
-        copyBestSamples();
+        copyBestSamples(pool_);
         stagnation_pools_ = curr_pool_ - best_pool_;
         if (stagnation_pools_ >= max_stagnation_pools_) {
             break;
         }
         ++curr_pool_;
+        if (curr_pool_ % cfg_.checkpoint_pools_ == 0) {
+            saveCheckpoint(false);
+        }
     }
 
+    checkpoint_.remove();
+}
+
+auto Optimizer::searchByAnnealing() -> void {
+    annealer_.setControl(control_);
+    best_loss_ = annealer_.search();
     spdlog::info(
-        "Optimization complete. Found {:d} candidate solutions.",
-        best_samples_.size()
+        "[Annealing]: best loss = {:8.5f} of {:d} chains",
+        best_loss_, annealer_.bests_.size()
     );
-    saveResults();
-    saveBaselines();
+    for (const Sample& sample : annealer_.bests_) {
+        if (archived_.insert(sample.getHash()).second) {
+            best_samples_.emplace_back(sample);
+        }
+    }
+    if (not annealer_.bests_.empty()) {
+        publish(annealer_.bests_.front());
+    }
+}
+
+auto Optimizer::searchByIslands() -> void {
+    optimizer::Islands islands;
+    islands.setControl(control_);
+    islands.setSeeds(loadSeeds());
+    spdlog::info("Running {:d} islands concurrently...", islands.size());
+    best_loss_ = islands.search(
+        MAX_POOLS * islands.size(), max_stagnation_pools_ * islands.size(),
+        [this](const optimizer::Pool& pool, const uz island, const uz round, const fz loss, const fz best_loss) {
+            spdlog::info(
+                "[Island {: >2d}, Round {: >3d}]: current loss = {:8.5f}, "
+                "best loss so far is {:8.5f}",
+                island, round, loss, best_loss
+            );
+            copyBestSamples(pool);
+            publish(pool);
+        }
+    );
+}
+
+auto Optimizer::searchByEnumeration() -> void {
+    optimizer::Enumerator enumerator;
+    enumerator.setControl(control_);
+    best_loss_ = enumerator.search();
+    spdlog::info(
+        "[Enumeration]: {:s} loss = {:8.5f}, kept {:d} best samples",
+        control_.stopRequested() ? "best" : "optimal", best_loss_, enumerator.bests_.size()
+    );
+    for (const Sample& sample : enumerator.bests_) {
+        if (archived_.insert(sample.getHash()).second) {
+            best_samples_.emplace_back(sample);
+        }
+    }
+    if (not enumerator.bests_.empty()) {
+        publish(enumerator.bests_.front());
+    }
+}
+
+auto Optimizer::searchByBranchAndBound() -> void {
+    optimizer::BranchAndBound solver;
+    solver.setControl(control_);
+    best_loss_ = solver.search();
+    spdlog::info(
+        "[Branch and Bound]: {:s} loss = {:8.5f} after {:d} nodes, kept {:d} best samples",
+        solver.isCertified() ? "optimal" : "best", best_loss_, solver.nodes(), solver.bests_.size()
+    );
+    for (const Sample& sample : solver.bests_) {
+        if (archived_.insert(sample.getHash()).second) {
+            best_samples_.emplace_back(sample);
+        }
+    }
+    if (not solver.bests_.empty()) {
+        publish(solver.bests_.front());
+    }
 }
 
-auto Optimizer::copyBestSamples() -> void {
+/**
+ * @brief 将搜索进度写入检查点.
+ * @param in_pool 当前样本池是否仍在搜索中; 为 false 时, 恢复后将开始新的样本池.
+ **/
+auto Optimizer::saveCheckpoint(const bool in_pool) -> void {
+    if (not cfg_.checkpoint_enabled_) return;
+
+    Checkpoint::Writer writer = checkpoint_.writer();
+    const auto [seed, seed_index] = layout::Manager::seedStream();
+    writer.write(seed.has_value()).write(seed.value_or(0)).write(seed_index);
+    writer.write(in_pool).write(curr_pool_).write(best_pool_)
+          .write(stagnation_pools_).write(best_loss_);
+    writer.write(best_samples_.size());
+    for (const Sample& sample : best_samples_) {
+        writer.write(sample);
+    }
+    pool_.save(writer);
+    writer.commit();
+}
+
+/**
+ * @brief 从检查点恢复搜索进度, 并重新评估已存档的样本.
+ * @return 恢复的样本池是否仍在搜索中; 没有可用的检查点时返回 false.
+ **/
+auto Optimizer::loadCheckpoint() -> bool {
+    if (not cfg_.resume_enabled_) return false;
+
+    std::optional<Checkpoint::Reader> reader = checkpoint_.reader();
+    if (not reader.has_value()) return false;
+
+    bool in_pool{};
+    try {
+        bool seeded{};
+        uint64_t seed{}, seed_index{};
+        reader->read(seeded).read(seed).read(seed_index);
+        // 在重新评估之前接续种子来源, 使恢复后的搜索可以复现
+        if (seeded) { layout::Manager::setSeed(seed, seed_index); }
+        reader->read(in_pool).read(curr_pool_).read(best_pool_)
+               .read(stagnation_pools_).read(best_loss_);
+        uz count{};
+        reader->read(count);
+        best_samples_.clear();
+        archived_.clear();
+        for (uz i = 0; i < count; ++i) {
+            Sample sample(layout::baselines::ALL.front());
+            reader->read(sample);
+            pool_.evl_.analyze(sample);
+            archived_.insert(sample.getHash());
+            best_samples_.emplace_back(std::move(sample));
+        }
+        pool_.load(*reader);
+    } catch (const FatalError& e) {
+        spdlog::warn("{:s}, starting from scratch.", e.what());
+        best_loss_ = std::numeric_limits<fz>::max();
+        curr_pool_ = best_pool_ = stagnation_pools_ = 0;
+        best_samples_.clear();
+        archived_.clear();
+        pool_.setSize(Resources::STATUS.at("pool_size").as_integer());
+        return false;
+    }
+
+    spdlog::info(
+        "Resumed from checkpoint: Pool {: >2d}, epoch {: >3d}, {:d} archived samples.",
+        curr_pool_, pool_.curr_epoch_, best_samples_.size()
+    );
+    return in_pool;
+}
+
+/**
+ * @brief 样本优于之前发布的所有样本时, 通过回调发布它.
+ **/
+auto Optimizer::publish(const Sample& sample) -> void {
+    if (not on_progress_ or sample.getLoss() >= published_loss_) return;
+    published_loss_ = sample.getLoss();
+    on_progress_(sample);
+}
+
+/**
+ * @brief 发布样本池中排名第一的样本; 未改进时不构造样本.
+ **/
+auto Optimizer::publish(const optimizer::Pool& pool) -> void {
+    const uz index = pool.population_.indexOf(0);
+    if (not on_progress_ or pool.population_.loss(index) >= published_loss_) return;
+    publish(pool.population_.toSample(index));
+}
+
+auto Optimizer::copyBestSamples(const optimizer::Pool& pool) -> void {
     uz count = 0;
+    const Population& population = pool.population_;
     for (uz i = 0; i < 100; ++i) {
-        if (const Sample& sample = *pool_.samples_[i];
-            std::ranges::find(best_samples_, sample) == best_samples_.end()) {
-            best_samples_.emplace_back(sample);
+        if (const uz index = population.indexOf(i);
+            archived_.insert(population.layout(index).getHash()).second) {
+            best_samples_.emplace_back(population.toSample(index));
             if (++count >= 30) { break; }
         }
     }
@@ -91,9 +376,29 @@ auto Optimizer::saveResults() -> void {
         os << stats;
         os.close();
 
-        if (saved_samples >= 5) { break; }
+        if (saved_samples >= MAX_RESULTS) { break; }
     }
     spdlog::info("Saved best {:d} samples...", saved_samples);
 }
 
+/**
+ * @brief 最优样本的损失低于 cache/status.toml 中记录的参考损失时, 更新参考损失, 供质量基准测试使用.
+ * @note 参考损失只在当前的归一化参数下有意义, 预处理重写 status.toml 时会将其丢弃.
+ **/
+auto Optimizer::saveReferenceLoss() const -> void {
+    if (best_samples_.empty()) return;
+
+    const fz loss = best_samples_.front().getLoss();
+    const std::string path = Utils::absPath("cache/status.toml");
+    Toml status = toml::parse<toml::ordered_type_config>(path);
+    if (status.contains("reference_loss") and status.at("reference_loss").as_floating() <= loss) return;
+
+    status["reference_loss"] = loss;
+    std::ofstream os;
+    os.open(path, std::ios::out);
+    os << toml::format(status);
+    os.close();
+    spdlog::info("Updated reference loss to {:8.5f}.", loss);
+}
+
 }
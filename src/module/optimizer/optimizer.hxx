@@ -2,15 +2,26 @@
 #define CLUBMOSS_OPTIMIZER_HXX
 
 #include "o_pool.hxx"
+#include "annealer.hxx"
+#include "islands.hxx"
+#include "enumerator.hxx"
+#include "branch_and_bound.hxx"
 
 namespace clubmoss {
 
 class Optimizer {
 public:
+    // 找到更优的样本时的回调, 各次调用互不重叠, 但在岛屿模式下由持有岛屿互斥锁的工作线程调用
+    using ProgressCallback = std::function<void(const Sample&)>;
+
     auto search() -> void;
 
+    auto setControl(const optimizer::Control& control) noexcept -> void;
+    auto setProgressCallback(ProgressCallback callback) -> void;
+
 private:
     optimizer::Pool pool_{};
+    optimizer::Annealer annealer_{};
 
     uz curr_pool_{0};
     uz best_pool_{0};
@@ -19,14 +30,46 @@ private:
     uz max_stagnation_pools_{25};
 
     static constexpr uz MAX_POOLS{50};
+    static constexpr uz MAX_RESULTS{5}; // 保存的结果数
 
     fz best_loss_{};
 
+    optimizer::Control control_{};
+    ProgressCallback on_progress_{};
+    fz published_loss_{std::numeric_limits<fz>::max()}; // 最近一次通过回调发布的损失
+
     std::vector<Sample> best_samples_{};
+    std::unordered_set<Hash> archived_{}; // 已存档样本的哈希值
+
+    Checkpoint checkpoint_{
+        "cache/optimizer.ckpt", {
+            "conf/layout.toml", "conf/metric.toml", "conf/score.toml", "conf/search.toml", "cache/status.toml",
+            "data/chinese/char.toml", "data/chinese/pair.toml", "data/chinese/seq.toml",
+            "data/english/char.toml", "data/english/pair.toml", "data/english/seq.toml",
+        }
+    };
+
+    inline static optimizer::Config& cfg_ = optimizer::Config::getInstance();
+
+    auto applyBudget() -> void;
+    auto loadSeeds() const -> std::vector<Layout>;
+
+    auto searchByPool() -> void;
+    auto searchByAnnealing() -> void;
+    auto searchByIslands() -> void;
+    auto searchByEnumeration() -> void;
+    auto searchByBranchAndBound() -> void;
+
+    auto saveCheckpoint(bool in_pool) -> void;
+    auto loadCheckpoint() -> bool;
+
+    auto publish(const Sample& sample) -> void;
+    auto publish(const optimizer::Pool& pool) -> void;
 
-    auto copyBestSamples() -> void;
+    auto copyBestSamples(const optimizer::Pool& pool) -> void;
     auto saveBaselines() -> void;
     auto saveResults() -> void;
+    auto saveReferenceLoss() const -> void;
 };
 
 }
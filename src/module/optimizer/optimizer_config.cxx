@@ -0,0 +1,123 @@
+#include "optimizer_config.hxx"
+
+namespace clubmoss::optimizer {
+
+auto Config::getInstance() -> Config& {
+    static Config instance;
+    return instance;
+}
+
+auto Config::loadCfg(const Toml& cfg) -> void {
+    Config& instance = getInstance();
+    instance.mode_ = fetchEnum<SearchMode>(cfg.at("mode"), "mode");
+    instance.loadAnnealingCfg(cfg.at("annealing"));
+    instance.loadIslandsCfg(cfg.at("islands"));
+    instance.loadCheckpointCfg(cfg.at("checkpoint"));
+    instance.loadEnumerationCfg(cfg.at("enumeration"));
+    instance.loadBranchAndBoundCfg(cfg.at("branch_and_bound"));
+    instance.loadWarmStartCfg(cfg.at("warm_start"));
+    instance.loadBudgetCfg(cfg.at("budget"));
+}
+
+auto Config::loadAnnealingCfg(const Toml& cfg) -> void {
+    chains_per_thread_ = fetchInt(cfg.at("chains_per_thread"), "chains_per_thread", 1, 1'000);
+    steps_per_chain_ = fetchInt(cfg.at("steps_per_chain"), "steps_per_chain", 1'000, 1'000'000'000);
+    schedule_ = fetchEnum<CoolingSchedule>(cfg.at("schedule"), "schedule");
+    initial_temperature_ = fetchFloat(cfg.at("initial_temperature"), "initial_temperature", 1e-9, 10.0);
+    final_temperature_ = fetchFloat(cfg.at("final_temperature"), "final_temperature", 1e-9, 10.0);
+    if (final_temperature_ > initial_temperature_) {
+        throw IllegalCfg(
+            "illegal `final_temperature` value",
+            cfg.at("final_temperature"), "should not exceed `initial_temperature`"
+        );
+    }
+}
+
+auto Config::loadIslandsCfg(const Toml& cfg) -> void {
+    num_islands_ = fetchInt(cfg.at("count"), "count", 0, 1'024);
+    island_pool_size_ = fetchInt(cfg.at("pool_size"), "pool_size", 100, 10'000);
+    if (island_pool_size_ % 2 != 0) {
+        throw IllegalCfg(
+            "illegal `pool_size` value",
+            cfg.at("pool_size"), "should be an even number"
+        );
+    }
+    migration_interval_ = fetchInt(cfg.at("migration_interval"), "migration_interval", 1, 1'000);
+    num_migrants_ = fetchInt(cfg.at("migrants"), "migrants", 1, island_pool_size_ / 2);
+}
+
+auto Config::loadCheckpointCfg(const Toml& cfg) -> void {
+    checkpoint_enabled_ = cfg.at("enabled").as_boolean();
+    resume_enabled_ = cfg.at("resume").as_boolean();
+    checkpoint_epochs_ = fetchInt(cfg.at("epochs"), "epochs", 1, 1'000);
+    checkpoint_pools_ = fetchInt(cfg.at("pools"), "pools", 1, 50);
+}
+
+auto Config::loadEnumerationCfg(const Toml& cfg) -> void {
+    max_permutations_ = fetchInt(cfg.at("max_permutations"), "max_permutations", 0, 1'000'000'000'000);
+}
+
+auto Config::loadBranchAndBoundCfg(const Toml& cfg) -> void {
+    max_nodes_ = fetchInt(cfg.at("max_nodes"), "max_nodes", 1'000, 1'000'000'000'000);
+}
+
+auto Config::loadWarmStartCfg(const Toml& cfg) -> void {
+    warm_start_enabled_ = cfg.at("enabled").as_boolean();
+    warm_start_results_ = cfg.at("results").as_boolean();
+    warm_start_baselines_ = cfg.at("baselines").as_boolean();
+    warm_start_ratio_ = fetchFloat(cfg.at("ratio"), "ratio", 0.0, 1.0);
+    warm_start_max_distance_ = fetchInt(cfg.at("max_distance"), "max_distance", 1, 100);
+}
+
+auto Config::loadBudgetCfg(const Toml& cfg) -> void {
+    budget_seconds_ = fetchInt(cfg.at("seconds"), "seconds", 0, 10'000'000);
+    budget_evaluations_ = fetchInt(cfg.at("evaluations"), "evaluations", 0, 1'000'000'000'000'000);
+    budget_min_pools_ = fetchInt(cfg.at("min_pools"), "min_pools", 1, 50);
+}
+
+/**
+ * @brief 按名称 (snake_case) 读取枚举值.
+ * @param node 存储名称的 Toml 节点.
+ * @param msg 字段名, 用于错误信息.
+ * @return 对应的枚举值.
+ **/
+template <typename Enum>
+auto Config::fetchEnum(const Toml& node, const std::string_view msg) -> Enum {
+    const std::string& name = node.as_string();
+    std::string candidates;
+    for (const Enum value : Enum::_values()) {
+        const std::string candidate = Utils::toSnakeCase(value._to_string());
+        if (candidate == name) {
+            return value;
+        }
+        candidates += std::format("{:s}\"{:s}\"", candidates.empty() ? "" : ", ", candidate);
+    }
+    throw IllegalCfg(
+        std::format("illegal `{:s}` value", msg),
+        node, std::format("should be one of {:s}", candidates)
+    );
+}
+
+auto Config::fetchFloat(const Toml& node, const std::string_view msg, const fz min, const fz max) -> fz {
+    const double value = node.as_floating();
+    if (value < min or value > max) {
+        throw IllegalCfg(
+            std::format("illegal `{:s}` value", msg),
+            node, std::format("should be in range [{:g}, {:g}]", min, max)
+        );
+    }
+    return static_cast<fz>(value);
+}
+
+auto Config::fetchInt(const Toml& node, const std::string_view msg, const uz min, const uz max) -> uz {
+    const auto value = node.as_integer();
+    if (value < 0 or static_cast<uz>(value) < min or static_cast<uz>(value) > max) {
+        throw IllegalCfg(
+            std::format("illegal `{:s}` value", msg),
+            node, std::format("should be in range [{:d}, {:d}]", min, max)
+        );
+    }
+    return static_cast<uz>(value);
+}
+
+}
@@ -0,0 +1,111 @@
+#ifndef CLUBMOSS_OPTIMIZER_CONFIG_HXX
+#define CLUBMOSS_OPTIMIZER_CONFIG_HXX
+
+#include "../../common/utils.hxx"
+
+namespace clubmoss {
+class Optimizer;
+class Preprocessor;
+}
+
+namespace clubmoss::optimizer {
+
+// @formatter:off //
+BETTER_ENUM(
+    SearchMode, uz,
+    Pool           = 0,
+    Annealing      = 1,
+    Islands        = 2,
+    BranchAndBound = 3
+)
+
+BETTER_ENUM(
+    CoolingSchedule, uz,
+    Exponential = 0,
+    Linear      = 1,
+    Logarithmic = 2
+)
+// @formatter:on //
+
+class Pool;
+class Annealer;
+class Islands;
+class Enumerator;
+class BranchAndBound;
+
+// 搜索设置 //
+class Config final {
+public:
+    Config(Config&&) = delete;
+    Config(const Config&) = delete;
+    Config& operator=(Config&&) = delete;
+    Config& operator=(const Config&) = delete;
+
+    static auto getInstance() -> Config&;
+
+    static auto loadCfg(const Toml& cfg) -> void;
+
+protected:
+    SearchMode mode_{SearchMode::Pool}; // 搜索模式
+
+    uz chains_per_thread_{4}; // 每个线程依次运行的退火链数
+    uz steps_per_chain_{2'000'000}; // 每条退火链的迭代步数
+    CoolingSchedule schedule_{CoolingSchedule::Exponential}; // 降温方式
+    fz initial_temperature_{0.02}; // 初始温度
+    fz final_temperature_{1e-5}; // 终止温度
+
+    uz num_islands_{0}; // 岛屿数量, 为 0 时等于线程数
+    uz island_pool_size_{1200}; // 每个岛屿的样本池大小
+    uz migration_interval_{10}; // 迁移间隔 (代数)
+    uz num_migrants_{4}; // 每次迁移的样本数
+
+    bool checkpoint_enabled_{true}; // 是否定期写入检查点
+    bool resume_enabled_{true}; // 是否从已有的检查点恢复
+    uz checkpoint_epochs_{50}; // 写入检查点的间隔 (代数)
+    uz checkpoint_pools_{1}; // 写入检查点的间隔 (样本池数)
+
+    uz max_permutations_{100'000'000}; // 排列总数不超过此值时穷举求解, 为 0 时不启用
+
+    uz max_nodes_{10'000'000}; // 分支定界最多访问的节点数
+
+    bool warm_start_enabled_{false}; // 是否以已知的优秀布局初始化样本池的一部分
+    bool warm_start_results_{true}; // 是否使用上次的结果
+    bool warm_start_baselines_{true}; // 是否使用兼容的基准布局
+    fz warm_start_ratio_{0.1}; // 以已知布局及其邻居初始化的样本比例
+    uz warm_start_max_distance_{8}; // 邻居与已知布局之间的最大交换次数
+
+    uz budget_seconds_{0}; // 墙钟时间预算 (秒), 为 0 时不限制
+    uz budget_evaluations_{0}; // 评估的布局数预算, 为 0 时不限制
+    uz budget_min_pools_{4}; // 预算至少分给的样本池数
+
+    Config() = default;
+
+private:
+    auto loadAnnealingCfg(const Toml& cfg) -> void;
+    auto loadIslandsCfg(const Toml& cfg) -> void;
+    auto loadCheckpointCfg(const Toml& cfg) -> void;
+    auto loadEnumerationCfg(const Toml& cfg) -> void;
+    auto loadBranchAndBoundCfg(const Toml& cfg) -> void;
+    auto loadWarmStartCfg(const Toml& cfg) -> void;
+    auto loadBudgetCfg(const Toml& cfg) -> void;
+
+    template <typename Enum>
+    static auto fetchEnum(const Toml& node, std::string_view msg) -> Enum;
+    static auto fetchFloat(const Toml& node, std::string_view msg, fz min, fz max) -> fz;
+    static auto fetchInt(const Toml& node, std::string_view msg, uz min, uz max) -> uz;
+
+    static constexpr char WHAT[]{"Illegal search config: {:s}"};
+    using IllegalCfg = IllegalToml<WHAT>;
+
+    friend class clubmoss::Optimizer;
+    friend class clubmoss::Preprocessor;
+    friend class Pool;
+    friend class Annealer;
+    friend class Islands;
+    friend class Enumerator;
+    friend class BranchAndBound;
+};
+
+}
+
+#endif //CLUBMOSS_OPTIMIZER_CONFIG_HXX
@@ -0,0 +1,51 @@
+#include <omp.h>
+#include "workers.hxx"
+
+namespace clubmoss::optimizer {
+
+/**
+ * @brief 为即将开始的并行区域预留槽位, 必须在并行区域之外调用.
+ * @note 只扩充槽位, 不构造上下文, 因此线程数不变时几乎没有开销.
+ **/
+auto Workers::prepare() -> void {
+    prepare(static_cast<uz>(omp_get_max_threads()));
+}
+
+/**
+ * @brief 为线程数由 num_threads 子句指定的并行区域预留槽位, 必须在并行区域之外调用.
+ * @param num_threads 并行区域的线程数.
+ **/
+auto Workers::prepare(const uz num_threads) -> void {
+    if (workers_.size() < num_threads) {
+        workers_.resize(num_threads);
+    }
+}
+
+/**
+ * @brief 当前线程的工作上下文.
+ * @note 每个线程只访问自己的槽位, 因此首次使用时的构造无需加锁.
+ **/
+auto Workers::local() -> Worker& {
+    std::unique_ptr<Worker>& worker = workers_[static_cast<uz>(omp_get_thread_num())];
+    if (not worker) {
+        worker = std::make_unique<Worker>();
+    }
+    return *worker;
+}
+
+/**
+ * @brief 将各线程的计数器累加到 total 中并清零, 必须在并行区域之外调用.
+ **/
+auto Workers::collect(telemetry::Counters& total) noexcept -> void {
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        if (not worker) continue;
+        total.merge(worker->counters);
+        worker->counters.reset();
+    }
+}
+
+auto Workers::size() const noexcept -> uz {
+    return static_cast<uz>(std::ranges::count_if(workers_, [](const auto& worker) { return worker != nullptr; }));
+}
+
+}
@@ -0,0 +1,40 @@
+#ifndef CLUBMOSS_OPTIMIZER_WORKERS_HXX
+#define CLUBMOSS_OPTIMIZER_WORKERS_HXX
+
+#include "../evaluator/evaluator.hxx"
+#include "../telemetry/telemetry.hxx"
+
+namespace clubmoss::optimizer {
+
+// 单个线程的工作上下文, 独占一条缓存行以避免伪共享 //
+struct alignas(64) Worker final {
+    layout::Manager mgr{};
+    Evaluator evl{};
+    telemetry::Counters counters{};
+    std::vector<Layout> layouts{}; // 批量评估时的暂存区, 容量在复用时保留
+};
+
+// 各线程长期持有的工作上下文: 在第一次使用时构造, 此后在各代与各样本池之间复用 //
+class Workers final {
+public:
+    Workers() = default;
+
+    Workers(Workers&&) = delete;
+    Workers(const Workers&) = delete;
+    Workers& operator=(Workers&&) = delete;
+    Workers& operator=(const Workers&) = delete;
+
+    auto prepare() -> void;
+    auto prepare(uz num_threads) -> void;
+    auto local() -> Worker&;
+    auto collect(telemetry::Counters& total) noexcept -> void;
+
+    [[nodiscard]] auto size() const noexcept -> uz;
+
+protected:
+    std::vector<std::unique_ptr<Worker>> workers_{}; // 按线程编号索引, 尚未使用的线程为空
+};
+
+}
+
+#endif //CLUBMOSS_OPTIMIZER_WORKERS_HXX
@@ -10,7 +10,7 @@ auto Pool::search4min(const uz task_id) -> fz {
     sortSamplesAsc();
 
     while (curr_epoch_ < MAX_EPOCHS) {
-        if (const fz loss = samples_.front()->getLoss(); loss < best_loss_) {
+        if (const fz loss = population_.loss(population_.indexOf(0)); loss < best_loss_) {
             best_epoch_ = curr_epoch_;
             best_loss_ = loss;
         }
@@ -20,7 +20,7 @@ auto Pool::search4min(const uz task_id) -> fz {
         }
         ++curr_epoch_;
         updateAndEvaluateSamples(task_id);
-        sortSamplesAsc();
+        selectSamplesAsc();
     }
 
     updateMse();
@@ -41,7 +41,7 @@ auto Pool::search4max(const uz task_id) -> fz {
     sortSamplesDesc();
 
     while (curr_epoch_ < MAX_EPOCHS) {
-        if (const fz loss = samples_.front()->getLoss(); loss > best_loss_) {
+        if (const fz loss = population_.loss(population_.indexOf(0)); loss > best_loss_) {
             best_epoch_ = curr_epoch_;
             best_loss_ = loss;
         }
@@ -51,7 +51,7 @@ auto Pool::search4max(const uz task_id) -> fz {
         }
         ++curr_epoch_;
         updateAndEvaluateSamples(task_id);
-        sortSamplesDesc();
+        selectSamplesDesc();
     }
 
     updateMse();
@@ -65,37 +65,41 @@ auto Pool::search4max(const uz task_id) -> fz {
 }
 
 auto Pool::reinitAndEvaluateSamples(const uz task_id) noexcept -> void {
-    #pragma omp parallel for schedule(guided) shared(samples_, task_id) firstprivate(mgr_, evl_) lastprivate(mgr_, evl_) default (none)
+    workers_.prepare();
+    #pragma omp parallel for schedule(guided) shared(population_, workers_, task_id) default (none)
     for (uz i = 0; i < size_; ++i) {
-        mgr_.reinit(*samples_[i]);
-        evl_.measure(*samples_[i], task_id);
+        optimizer::Worker& worker = workers_.local();
+        worker.mgr.reinit(population_.layout(i));
+        worker.evl.analyze(population_, i, task_id);
     }
 }
 
 auto Pool::updateAndEvaluateSamples(const uz task_id) noexcept -> void {
-    #pragma omp parallel for schedule(guided) shared(samples_, task_id) firstprivate(mgr_, evl_) lastprivate(mgr_, evl_) default (none)
+    workers_.prepare();
+    #pragma omp parallel for schedule(guided) shared(population_, workers_, task_id) default (none)
     for (uz i = half_; i < size_; ++i) {
-        mgr_.mutate(*samples_[i], *samples_[i - half_]);
-        evl_.measure(*samples_[i], task_id);
+        optimizer::Worker& worker = workers_.local();
+        const uz parent = population_.indexOf(i - half_);
+        const uz child = population_.indexOf(i);
+        const auto [pos1, pos2] = worker.mgr.mutate(population_.layout(child), population_.layout(parent));
+        worker.evl.update(population_, child, parent, pos1, pos2, task_id);
     }
 }
 
 auto Pool::sortSamplesDesc() -> void {
-    std::sort(
-        &samples_.front(), &samples_[size_ - 1],
-        [](const std::unique_ptr<Sample>& lhs, const std::unique_ptr<Sample>& rhs) {
-            return lhs->getLoss() > rhs->getLoss();
-        }
-    );
+    population_.sort(std::greater{});
 }
 
 auto Pool::sortSamplesAsc() -> void {
-    std::sort(
-        &samples_.front(), &samples_[size_ - 1],
-        [](const std::unique_ptr<Sample>& lhs, const std::unique_ptr<Sample>& rhs) {
-            return lhs->getLoss() < rhs->getLoss();
-        }
-    );
+    population_.sort(std::less{});
+}
+
+auto Pool::selectSamplesDesc() -> void {
+    population_.select(half_, std::greater{});
+}
+
+auto Pool::selectSamplesAsc() -> void {
+    population_.select(half_, std::less{});
 }
 
 }
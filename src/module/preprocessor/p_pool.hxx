@@ -28,6 +28,9 @@ protected:
     auto sortSamplesDesc() -> void;
     auto sortSamplesAsc() -> void;
 
+    auto selectSamplesDesc() -> void;
+    auto selectSamplesAsc() -> void;
+
 private:
     friend class clubmoss::Preprocessor;
 };
@@ -1,19 +1,39 @@
+#include <omp.h>
+#include <chrono>
 #include "preprocessor.hxx"
 
 namespace clubmoss {
 
 auto Preprocessor::run() -> void {
+    loadCheckpoint();
     searchExtremes();
     estimateSize();
     saveStatus();
+    checkpoint_.remove();
+    resumed_ = false;
 }
 
+/**
+ * @brief 求各项任务的最小与最大代价.
+ * @note 击键代价的极值可以精确求解, 其余的任务相互独立, 由多个工作线程并发搜索.
+ **/
 auto Preprocessor::searchExtremes() -> void {
-    for (const MetricId metric : MetricId::_values()) {
-        for (const Language language : Language::_values()) {
-            minimizeCosts(metric, language);
-            maximizeCosts(metric, language);
+    if (not resumed_) {
+        stage_ = 0;
+    }
+    if (stage_ < EXTREMES_STAGES) {
+        if (not beginStage()) {
+            for (uz i = 0; i < EXTREME_TASKS; ++i) {
+                tasks_[i].reset(i);
+            }
         }
+        solveKeyCosts();
+        runExtremeTasks();
+        for (const ExtremeTask& task : tasks_) {
+            (task.maximize ? max_costs_ : min_costs_)[task.task_id] = task.best_cost;
+        }
+        stage_ = EXTREMES_STAGES;
+        saveCheckpoint(false);
     }
     for (const MetricId metric : MetricId::_values()) {
         for (const Language language : Language::_values()) {
@@ -26,93 +46,168 @@ auto Preprocessor::searchExtremes() -> void {
     }
 }
 
-auto Preprocessor::minimizeCosts(const MetricId metric, const Language language) -> void {
-    const uz task_id = Utils::taskIdOf(metric, language);
-    min_costs_[task_id] = std::numeric_limits<fz>::max();
-    pool_.max_stagnation_epochs_ = 250;
-    curr_pool_ = best_pool_ = 0;
-    candidates_.clear();
-
-    spdlog::info(
-        "Searching for minimum cost for {} metric in {} statistics...",
-        metric._to_string(), language._to_string()
-    );
+/**
+ * @brief 将击键代价的极值作为线性指派问题精确求解, 并将相应的任务标记为已完成.
+ **/
+auto Preprocessor::solveKeyCosts() -> void {
+    for (const Language language : Language::_values()) {
+        const auto start = std::chrono::steady_clock::now();
+        const metric::KeyCost metric(Resources::KC_DATA[language]);
+        const auto [min_cost, max_cost] = metric.extremes();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start
+        );
 
-    while (curr_pool_ < MAX_POOLS) {
-        const fz min_cost = pool_.search4min(task_id);
-        if (min_cost < min_costs_[task_id]) {
-            min_costs_[task_id] = min_cost;
-            candidates_.insert(min_cost);
-            best_pool_ = curr_pool_;
+        const uz task_id = Utils::taskIdOf(MetricId::KeyCost, language);
+        for (ExtremeTask& task : std::span(tasks_).subspan(task_id * 2, 2)) {
+            task.best_cost = task.maximize ? max_cost : min_cost;
+            task.finished = true;
         }
         spdlog::info(
-            "[Pool {: >2d}]: found {:8.5f}, current best is {:8.5f} in Pool {: >2d}",
-            curr_pool_, min_cost, min_costs_[task_id], best_pool_
+            "[KeyCost - {}] Solved exactly: [{:8.5f}, {:8.5f}] in {:d} us.",
+            language._to_string(), min_cost, max_cost, elapsed.count()
         );
-        if (curr_pool_ % 5 == 0) {
-            max_stagnation_pools_ = std::clamp(
-                candidates_.size() * 5uz, 5uz, 15uz
-            );
-        }
-        stagnation_pools_ = curr_pool_ - best_pool_;
-        if (stagnation_pools_ >= max_stagnation_pools_) {
-            break;
-        }
-        ++curr_pool_;
     }
 }
 
-auto Preprocessor::maximizeCosts(const MetricId metric, const Language language) -> void {
-    const uz task_id = Utils::taskIdOf(metric, language);
-    max_costs_[task_id] = std::numeric_limits<fz>::min();
-    pool_.max_stagnation_epochs_ = 250;
-    curr_pool_ = best_pool_ = 0;
-    candidates_.clear();
+/**
+ * @brief 由工作线程依次领取并运行尚未完成的任务, 每个工作线程独占一个样本池.
+ * @note 线程数多于任务数时, 样本池内部的并行区域使用嵌套的线程组, 否则由工作线程串行执行.
+ **/
+auto Preprocessor::runExtremeTasks() -> void {
+    const uz num_threads = static_cast<uz>(omp_get_max_threads());
+    const uz num_workers = std::min(num_threads, EXTREME_TASKS);
+    const uz inner_threads = std::max(num_threads / num_workers, 1uz);
+
+    std::vector<std::unique_ptr<preprocessor::Pool>> pools;
+    for (uz i = 0; i < num_workers; ++i) {
+        pools.emplace_back(std::make_unique<preprocessor::Pool>());
+    }
 
+    next_task_ = 0;
+    finished_tasks_ = static_cast<uz>(std::ranges::count_if(tasks_, &ExtremeTask::finished));
     spdlog::info(
-        "Searching for maximum cost for {} metric in {} statistics...",
-        metric._to_string(), language._to_string()
+        "Searching for extreme costs: {:d} tasks on {:d} workers x {:d} threads...",
+        EXTREME_TASKS - finished_tasks_, num_workers, inner_threads
     );
 
-    while (curr_pool_ < MAX_POOLS) {
-        const fz max_cost = pool_.search4max(task_id);
-        if (max_cost > max_costs_[task_id]) {
-            max_costs_[task_id] = max_cost;
-            candidates_.insert(max_cost);
-            best_pool_ = curr_pool_;
+    const int max_active_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(inner_threads > 1 ? 2 : 1);
+
+    #pragma omp parallel num_threads(static_cast<int>(num_workers)) default(shared)
+    {
+        omp_set_num_threads(static_cast<int>(inner_threads));
+        preprocessor::Pool& pool = *pools[static_cast<uz>(omp_get_thread_num())];
+        for (uz i = next_task_.fetch_add(1); i < EXTREME_TASKS; i = next_task_.fetch_add(1)) {
+            runExtremeTask(pool, tasks_[i]);
         }
+    }
+
+    omp_set_max_active_levels(max_active_levels);
+}
+
+/**
+ * @brief 在 pool 上运行一项任务, 直到停滞或样本池数用尽.
+ * @param pool 工作线程独占的样本池.
+ * @param task 任务, 可能已从检查点恢复了部分进度.
+ **/
+auto Preprocessor::runExtremeTask(preprocessor::Pool& pool, ExtremeTask& task) -> void {
+    if (task.finished) return;
+    pool.max_stagnation_epochs_ = 250;
+
+    while (true) {
+        const fz cost = task.maximize ? pool.search4max(task.task_id) : pool.search4min(task.task_id);
+
+        std::lock_guard lock(mutex_);
+        const uz curr_pool = task.curr_pool;
+        const bool running = task.advance(cost);
         spdlog::info(
-            "[Pool {: >2d}]: found {:8.5f}, current best is {:8.5f} in Pool {: >2d}",
-            curr_pool_, max_cost, max_costs_[task_id], best_pool_
+            "[{:s}] Pool {: >2d}: found {:8.5f}, current best is {:8.5f} in Pool {: >2d}",
+            task.label(), curr_pool, cost, task.best_cost, task.best_pool
         );
-        if (curr_pool_ % 5 == 0) {
-            max_stagnation_pools_ = std::clamp(
-                candidates_.size() * 5uz, 5uz, 15uz
+        if (not running) {
+            ++finished_tasks_;
+            spdlog::info(
+                "[{:s}] Finished with {:8.5f}, {:d} of {:d} tasks done.",
+                task.label(), task.best_cost, finished_tasks_, EXTREME_TASKS
             );
+            saveCheckpoint(true);
+            return;
         }
-        stagnation_pools_ = curr_pool_ - best_pool_;
-        if (stagnation_pools_ >= max_stagnation_pools_) {
-            break;
+        if (task.curr_pool % cfg_.checkpoint_pools_ == 0) {
+            saveCheckpoint(true);
         }
-        ++curr_pool_;
     }
 }
 
-auto Preprocessor::estimateSize() -> void {
-    best_size_ = 4800;
-    const fz best_loss = tryPoolSize(4800);
-    for (const uz size : {2400, 1200, 600, 300}) {
-        const fz loss = tryPoolSize(size);
-        if (loss > best_loss) return;
-        best_size_ = size;
+/**
+ * @brief 重置为第 index 项任务的初始状态.
+ * @param index 任务序号: 偶数求最小代价, 奇数求最大代价, 任务编号为 index / 2.
+ **/
+auto Preprocessor::ExtremeTask::reset(const uz index) -> void {
+    task_id = index / 2;
+    maximize = index % 2 != 0;
+    finished = false;
+    curr_pool = best_pool = 0;
+    max_stagnation_pools = 5;
+    best_cost = maximize ? std::numeric_limits<fz>::lowest() : std::numeric_limits<fz>::max();
+    candidates.clear();
+}
+
+/**
+ * @brief 记录一个样本池的搜索结果.
+ * @param cost 本次找到的代价.
+ * @return 是否需要继续搜索.
+ **/
+auto Preprocessor::ExtremeTask::advance(const fz cost) -> bool {
+    if (maximize ? cost > best_cost : cost < best_cost) {
+        best_cost = cost;
+        candidates.insert(cost);
+        best_pool = curr_pool;
+    }
+    if (curr_pool % 5 == 0) {
+        max_stagnation_pools = std::clamp(candidates.size() * 5uz, 5uz, 15uz);
     }
+    if (curr_pool - best_pool >= max_stagnation_pools or curr_pool + 1 >= MAX_POOLS) {
+        finished = true;
+        return false;
+    }
+    ++curr_pool;
+    return true;
+}
 
+auto Preprocessor::ExtremeTask::label() const -> std::string {
+    const auto metric = MetricId::_from_integral(task_id / Language::_size());
+    const auto language = Language::_from_integral(task_id % Language::_size());
+    return std::format("{} - {} - {}", metric._to_string(), language._to_string(), maximize ? "max" : "min");
+}
+
+auto Preprocessor::estimateSize() -> void {
+    if (not resumed_) {
+        stage_ = EXTREMES_STAGES;
+    }
+    while (stage_ < ALL_STAGES) {
+        const uz trial = stage_ - EXTREMES_STAGES;
+        const fz loss = tryPoolSize(POOL_SIZES[trial]);
+        if (trial == 0) {
+            base_loss_ = loss;
+        } else if (loss > base_loss_) {
+            stage_ = ALL_STAGES;
+            saveCheckpoint(false);
+            return;
+        }
+        best_size_ = POOL_SIZES[trial];
+        ++stage_;
+        saveCheckpoint(false);
+    }
 }
 
 auto Preprocessor::tryPoolSize(const uz pool_size) -> fz {
-    best_loss_ = std::numeric_limits<fz>::max();
-    curr_pool_ = best_pool_ = 0;
-    max_stagnation_pools_ = 15;
+    if (not beginStage()) {
+        best_loss_ = std::numeric_limits<fz>::max();
+        curr_pool_ = best_pool_ = 0;
+        max_stagnation_pools_ = 15;
+    }
     pool_.setSize(pool_size);
 
     spdlog::info("Testing pool of {} samples...", pool_size);
@@ -132,11 +227,104 @@ auto Preprocessor::tryPoolSize(const uz pool_size) -> fz {
             break;
         }
         ++curr_pool_;
+        if (curr_pool_ % cfg_.checkpoint_pools_ == 0) {
+            saveCheckpoint(true);
+        }
     }
 
     return best_loss_;
 }
 
+/**
+ * @brief 开始当前阶段的搜索.
+ * @return 是否已从检查点恢复了本阶段的进度; 为 false 时, 调用者应当重置本阶段的状态.
+ **/
+auto Preprocessor::beginStage() -> bool {
+    return std::exchange(in_stage_, false);
+}
+
+/**
+ * @brief 将搜索进度写入检查点.
+ * @param in_stage 当前阶段是否仍在搜索中; 为 false 时, 恢复后将从第 stage_ 阶段的开头开始.
+ * @note 只在样本池之间写入, 因此样本池内的布局无需保存, 只需保存其停滞阈值.
+ *       并发搜索极值时, 调用者应当持有 mutex_.
+ **/
+auto Preprocessor::saveCheckpoint(const bool in_stage) -> void {
+    if (not cfg_.checkpoint_enabled_) return;
+
+    Checkpoint::Writer writer = checkpoint_.writer();
+    const auto [seed, seed_index] = layout::Manager::seedStream();
+    writer.write(seed.has_value()).write(seed.value_or(0)).write(seed_index);
+    writer.write(stage_).write(in_stage)
+          .write(curr_pool_).write(best_pool_).write(max_stagnation_pools_)
+          .write(best_loss_).write(base_loss_).write(best_size_)
+          .write(min_costs_).write(max_costs_)
+          .write(pool_.max_stagnation_epochs_);
+    for (const ExtremeTask& task : tasks_) {
+        writer.write(task.finished)
+              .write(task.curr_pool).write(task.best_pool).write(task.max_stagnation_pools)
+              .write(task.best_cost).write(task.candidates.size());
+        for (const fz candidate : task.candidates) {
+            writer.write(candidate);
+        }
+    }
+    writer.commit();
+}
+
+/**
+ * @brief 从检查点恢复搜索进度; 没有可用的检查点时从头开始.
+ **/
+auto Preprocessor::loadCheckpoint() -> void {
+    resumed_ = in_stage_ = false;
+    if (not cfg_.resume_enabled_) return;
+
+    std::optional<Checkpoint::Reader> reader = checkpoint_.reader();
+    if (not reader.has_value()) return;
+
+    try {
+        bool seeded{};
+        uint64_t seed{}, seed_index{};
+        reader->read(seeded).read(seed).read(seed_index);
+        // 接续种子来源, 使恢复后的搜索可以复现
+        if (seeded) { layout::Manager::setSeed(seed, seed_index); }
+        reader->read(stage_).read(in_stage_)
+               .read(curr_pool_).read(best_pool_).read(max_stagnation_pools_)
+               .read(best_loss_).read(base_loss_).read(best_size_)
+               .read(min_costs_).read(max_costs_)
+               .read(pool_.max_stagnation_epochs_);
+        for (uz i = 0; i < EXTREME_TASKS; ++i) {
+            ExtremeTask& task = tasks_[i];
+            task.reset(i);
+            uz count{};
+            reader->read(task.finished)
+                   .read(task.curr_pool).read(task.best_pool).read(task.max_stagnation_pools)
+                   .read(task.best_cost).read(count);
+            for (uz j = 0; j < count; ++j) {
+                fz candidate{};
+                reader->read(candidate);
+                task.candidates.insert(candidate);
+            }
+        }
+        if (stage_ > ALL_STAGES) {
+            throw FatalError(std::format("Illegal stage {:d} in checkpoint", stage_));
+        }
+    } catch (const FatalError& e) {
+        spdlog::warn("{:s}, starting from scratch.", e.what());
+        in_stage_ = false;
+        return;
+    }
+
+    resumed_ = true;
+    if (stage_ < EXTREMES_STAGES) {
+        spdlog::info(
+            "Resumed from checkpoint: {:d} of {:d} extreme tasks done.",
+            std::ranges::count_if(tasks_, &ExtremeTask::finished), EXTREME_TASKS
+        );
+    } else {
+        spdlog::info("Resumed from checkpoint: stage {:d} of {:d}, Pool {: >2d}.", stage_, ALL_STAGES, curr_pool_);
+    }
+}
+
 auto Preprocessor::saveStatus() -> void {
     std::array<fz, TASK_COUNT> biases{};
     std::array<fz, TASK_COUNT> ranges{};
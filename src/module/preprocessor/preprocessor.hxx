@@ -1,7 +1,11 @@
 #ifndef PREPROCESSOR_HXX
 #define PREPROCESSOR_HXX
 
+#include <mutex>
+#include <atomic>
+
 #include "p_pool.hxx"
+#include "../optimizer/optimizer_config.hxx"
 
 namespace clubmoss {
 
@@ -18,6 +22,40 @@ protected:
 private:
     preprocessor::Pool pool_{};
 
+    // 单项极值搜索: 在某种语言的语料上求某项指标的最小或最大代价 //
+    struct ExtremeTask {
+        uz task_id{0};
+        bool maximize{false};
+        bool finished{false};
+
+        uz curr_pool{0};
+        uz best_pool{0};
+        uz max_stagnation_pools{5};
+
+        fz best_cost{};
+        std::set<fz> candidates{};
+
+        auto reset(uz index) -> void;
+        auto advance(fz cost) -> bool;
+        [[nodiscard]] auto label() const -> std::string;
+    };
+
+    static constexpr uz EXTREME_TASKS{TASK_COUNT * 2};
+
+    std::array<ExtremeTask, EXTREME_TASKS> tasks_{};
+    std::atomic<uz> next_task_{0}; // 下一个待领取的任务
+    uz finished_tasks_{0};
+    std::mutex mutex_; // 保护各项任务的进度, 以及检查点的写入
+
+    // 搜索分为若干阶段: 首先并发地求各项任务的最小与最大代价, 然后依次测试各个样本池大小 //
+    uz stage_{0};
+    bool resumed_{false}; // 是否已从检查点恢复了阶段
+    bool in_stage_{false}; // 是否已从检查点恢复了阶段内的进度
+
+    static constexpr uz EXTREMES_STAGES{1};
+    static constexpr std::array<uz, 5> POOL_SIZES{4800, 2400, 1200, 600, 300};
+    static constexpr uz ALL_STAGES{EXTREMES_STAGES + POOL_SIZES.size()};
+
     uz curr_pool_{0};
     uz best_pool_{0};
 
@@ -27,16 +65,31 @@ private:
     static constexpr uz MAX_POOLS{50};
 
     fz best_loss_{};
-    std::set<fz> candidates_{};
 
     uz best_size_{};
+    fz base_loss_{};
     std::array<fz, TASK_COUNT> min_costs_{};
     std::array<fz, TASK_COUNT> max_costs_{};
 
-    auto minimizeCosts(MetricId metric, Language language) -> void;
-    auto maximizeCosts(MetricId metric, Language language) -> void;
+    auto solveKeyCosts() -> void;
+    auto runExtremeTasks() -> void;
+    auto runExtremeTask(preprocessor::Pool& pool, ExtremeTask& task) -> void;
 
     auto tryPoolSize(uz pool_size) -> fz;
+
+    Checkpoint checkpoint_{
+        "cache/preprocessor.ckpt", {
+            "conf/layout.toml", "conf/metric.toml",
+            "data/chinese/char.toml", "data/chinese/pair.toml", "data/chinese/seq.toml",
+            "data/english/char.toml", "data/english/pair.toml", "data/english/seq.toml",
+        }
+    };
+
+    inline static optimizer::Config& cfg_ = optimizer::Config::getInstance();
+
+    auto beginStage() -> bool;
+    auto saveCheckpoint(bool in_stage) -> void;
+    auto loadCheckpoint() -> void;
 };
 
 }
@@ -6,6 +6,7 @@
 #include "../metric/dis_cost/dis_cost.hxx"
 #include "../metric/seq_cost/seq_cost.hxx"
 #include "../module/evaluator/sample.hxx"
+#include "../module/optimizer/optimizer_config.hxx"
 
 namespace clubmoss {
 
@@ -18,26 +19,42 @@ class Resources {
     inline static const Toml LAYOUT_CONFIG = parse("conf/layout.toml");
     inline static const Toml METRIC_CONFIG = parse("conf/metric.toml");
     inline static const Toml SCORE_CONFIG  = parse("conf/score.toml");
-
-    inline static const Toml ZH_CHAR_FREQ = parse("data/chinese/char.toml");
-    inline static const Toml EN_CHAR_FREQ = parse("data/english/char.toml");
-    inline static const Toml ZH_PAIR_FREQ = parse("data/chinese/pair.toml");
-    inline static const Toml EN_PAIR_FREQ = parse("data/english/pair.toml");
-    inline static const Toml ZH_SEQ_FREQ  = parse("data/chinese/seq.toml");
-    inline static const Toml EN_SEQ_FREQ  = parse("data/english/seq.toml");
+    inline static const Toml SEARCH_CONFIG = parse("conf/search.toml");
     // @formatter:on //
 
+    // 编译后的二进制语料, 存在且有效时无需解析 data/ 目录下的 TOML 文件
+    inline static const std::optional<metric::Corpus> CORPUS = metric::Corpus::open();
+
+    /**
+     * @brief 加载某种语言的语料数据: 优先使用编译后的语料, 否则解析相应的 TOML 文件.
+     * @param language 语言.
+     * @param file_name 语料文件名 (例如 char.toml).
+     * @return 只读的语料数据, 所有指标实例共享同一份.
+     **/
+    template <typename Data>
+    static auto load(const Language language, const std::string_view file_name) -> std::shared_ptr<const Data> {
+        if (CORPUS.has_value()) {
+            return std::make_shared<const Data>(*CORPUS, language);
+        }
+        return std::make_shared<const Data>(
+            parse(std::format("data/{:s}/{:s}", Utils::toSnakeCase(language._to_string()), file_name))
+        );
+    }
+
 public:
     inline static const Toml STATUS = parse("cache/status.toml");
 
-    inline static std::array<metric::key_cost::Data, Language::_size()> KC_DATA{
-        metric::key_cost::Data(ZH_CHAR_FREQ), metric::key_cost::Data(EN_CHAR_FREQ)
+    inline static std::array<std::shared_ptr<const metric::key_cost::Data>, Language::_size()> KC_DATA{
+        load<metric::key_cost::Data>(Language::Chinese, "char.toml"),
+        load<metric::key_cost::Data>(Language::English, "char.toml"),
     };
-    inline static std::array<metric::dis_cost::Data, Language::_size()> DC_DATA{
-        metric::dis_cost::Data(ZH_PAIR_FREQ), metric::dis_cost::Data(EN_PAIR_FREQ)
+    inline static std::array<std::shared_ptr<const metric::dis_cost::Data>, Language::_size()> DC_DATA{
+        load<metric::dis_cost::Data>(Language::Chinese, "pair.toml"),
+        load<metric::dis_cost::Data>(Language::English, "pair.toml"),
     };
-    inline static std::array<metric::seq_cost::Data, Language::_size()> SC_DATA{
-        metric::seq_cost::Data(ZH_SEQ_FREQ), metric::seq_cost::Data(EN_SEQ_FREQ)
+    inline static std::array<std::shared_ptr<const metric::seq_cost::Data>, Language::_size()> SC_DATA{
+        load<metric::seq_cost::Data>(Language::Chinese, "seq.toml"),
+        load<metric::seq_cost::Data>(Language::English, "seq.toml"),
     };
 
 private:
@@ -45,6 +62,7 @@ private:
         layout::Manager::loadCfg(LAYOUT_CONFIG),
         metric::Config::loadCfg(METRIC_CONFIG, SCORE_CONFIG),
         Sample::loadCfg(SCORE_CONFIG, STATUS),
+        optimizer::Config::loadCfg(SEARCH_CONFIG),
         true
     );
 };
@@ -0,0 +1,37 @@
+#include "telemetry.hxx"
+
+namespace clubmoss::telemetry {
+
+auto Counters::merge(const Counters& other) noexcept -> void {
+    std::ranges::transform(calls, other.calls, calls.begin(), std::plus{});
+    std::ranges::transform(nanos, other.nanos, nanos.begin(), std::plus{});
+    evaluations += other.evaluations;
+}
+
+auto Counters::reset() noexcept -> void {
+    calls.fill(0);
+    nanos.fill(0);
+    evaluations = 0;
+}
+
+/**
+ * @brief 设置统计数据的回调.
+ * @param callback 回调函数; 为空时关闭遥测, 探针不再计时.
+ **/
+auto Telemetry::setCallback(Callback callback) -> void {
+    std::lock_guard lock(mutex_);
+    enabled_ = static_cast<bool>(callback);
+    callback_ = std::move(callback);
+}
+
+/**
+ * @brief 发送一份统计数据; 多个样本池并发运行时, 回调依次执行.
+ **/
+auto Telemetry::emit(const Report& report) -> void {
+    std::lock_guard lock(mutex_);
+    if (callback_) {
+        callback_(report);
+    }
+}
+
+}
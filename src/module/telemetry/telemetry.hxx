@@ -0,0 +1,98 @@
+#ifndef CLUBMOSS_TELEMETRY_HXX
+#define CLUBMOSS_TELEMETRY_HXX
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+#include "../../common/utils.hxx"
+
+namespace clubmoss::telemetry {
+
+// @formatter:off //
+BETTER_ENUM(
+    Probe, uz,
+    Mutate  = 0, // 生成与变异布局
+    Analyze = 1, // 评估样本
+    Sort    = 2, // 排序与选择
+    Unique  = 3  // 消除重复样本
+)
+
+BETTER_ENUM(
+    ReportKind, uz,
+    Epoch = 0, // 一代结束
+    Pool  = 1  // 一个样本池结束
+)
+// @formatter:on //
+
+// 单个线程的计数器, 只由所属线程写入, 在并行区域结束后汇总, 因此无需原子操作 //
+struct alignas(64) Counters final {
+    std::array<uint64_t, Probe::_size()> calls{}; // 各探针的调用次数
+    std::array<uint64_t, Probe::_size()> nanos{}; // 各探针的累计耗时 (纳秒)
+    uint64_t evaluations{0}; // 评估的布局数, 包括去重与迁入时的重新评估
+
+    auto merge(const Counters& other) noexcept -> void;
+    auto reset() noexcept -> void;
+};
+
+// 一代或一个样本池的统计数据 //
+struct Report final {
+    ReportKind kind{ReportKind::Epoch};
+    uz pool{0}; // 样本池的轮次
+    uz epoch{0}; // 当前代数
+    uz stagnation_epochs{0}; // 停滞代数
+    fz best_loss{0.0}; // 本轮的最优损失
+    fz seconds{0.0}; // 墙钟时间 (秒)
+    Counters counters{}; // 各线程计数器之和
+};
+
+// 遥测: 计时探针与统计数据的回调, 未设置回调时探针不计时 //
+class Telemetry final {
+public:
+    using Callback = std::function<void(const Report&)>;
+    using Clock = std::chrono::steady_clock;
+
+    static auto setCallback(Callback callback) -> void;
+    static auto emit(const Report& report) -> void;
+
+    [[nodiscard]] static auto enabled() noexcept -> bool {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 执行一个操作, 并在启用遥测时将其调用次数与耗时计入计数器.
+     * @param counters 当前线程的计数器.
+     * @param probe 探针.
+     * @param op 待执行的操作.
+     * @return 操作的返回值.
+     **/
+    template <typename Op>
+    static auto time(Counters& counters, const Probe probe, Op&& op) -> decltype(op()) {
+        if (not enabled()) {
+            return op();
+        }
+        const Clock::time_point start = Clock::now();
+        struct Guard {
+            Counters& counters;
+            uz probe;
+            Clock::time_point start;
+            ~Guard() {
+                counters.calls[probe] += 1;
+                counters.nanos[probe] += static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()
+                );
+            }
+        } guard{counters, probe, start};
+        return op();
+    }
+
+private:
+    inline static std::atomic<bool> enabled_{false};
+    inline static std::mutex mutex_{}; // 保护 callback_, 并使回调串行执行
+    inline static Callback callback_{};
+};
+
+}
+
+#endif //CLUBMOSS_TELEMETRY_HXX
@@ -0,0 +1,40 @@
+#include <random>
+#include <doctest/doctest.h>
+
+#include "../../src/common/assignment.hxx"
+
+namespace clubmoss::test {
+
+TEST_SUITE("Test Assignment") {
+
+    TEST_CASE("test Assignment::minimize() and maximize() against brute force") {
+        std::mt19937_64 engine{42};
+        std::uniform_real_distribution<fz> dist(-5.0, 5.0);
+
+        for (uz n = 1; n <= 7; ++n) {
+            for (uz trial = 0; trial < 20; ++trial) {
+                std::vector<fz> costs(n * n);
+                std::ranges::generate(costs, [&] { return dist(engine); });
+
+                std::vector<uz> perm(n);
+                std::iota(perm.begin(), perm.end(), 0uz);
+                fz min_total = std::numeric_limits<fz>::max();
+                fz max_total = std::numeric_limits<fz>::lowest();
+                do {
+                    const fz total = Assignment::totalOf(costs, n, perm);
+                    min_total = std::min(min_total, total);
+                    max_total = std::max(max_total, total);
+                } while (std::ranges::next_permutation(perm).found);
+
+                const std::vector<uz> min_assignment = Assignment::minimize(costs, n);
+                const std::vector<uz> max_assignment = Assignment::maximize(costs, n);
+                REQUIRE(std::ranges::is_permutation(min_assignment, perm));
+                REQUIRE(std::ranges::is_permutation(max_assignment, perm));
+                REQUIRE_EQ(Assignment::totalOf(costs, n, min_assignment), doctest::Approx(min_total));
+                REQUIRE_EQ(Assignment::totalOf(costs, n, max_assignment), doctest::Approx(max_total));
+            }
+        }
+    }
+}
+
+}
@@ -74,6 +74,38 @@ TEST_SUITE("Test Layout") {
             CHECK_EQ(layouts[2], lc);
         }
     }
+
+    TEST_CASE("test Layout hash") {
+
+        class SwappableLayout : public Layout {
+        public:
+            explicit SwappableLayout(const std::string_view seq) : Layout(seq) {}
+            using Layout::swap2Keys;
+        };
+
+        SUBCASE("consistency") {
+            REQUIRE_EQ(Layout(QWERTY_SEQ).getHash(), Layout(QWERTY_SEQ).getHash());
+            REQUIRE_NE(Layout(QWERTY_SEQ).getHash(), Layout(DVORAK_SEQ).getHash());
+            REQUIRE_NE(Layout(QWERTY_SEQ).getHash(), 0);
+        }
+
+        SUBCASE("swap2Keys()") {
+            SwappableLayout layout(QWERTY_SEQ);
+            const Hash origin = layout.getHash();
+            layout.swap2Keys(0, 1);
+            CHECK_EQ(layout.getHash(), Layout("WQERTYUIOPASDFGHJKL;ZXCVBNM,./").getHash());
+            layout.swap2Keys(0, 1);
+            CHECK_EQ(layout.getHash(), origin);
+
+            Prng prng;
+            for (uz i = 0; i < 1000; ++i) {
+                const Pos pos1 = static_cast<Pos>(prng() % KEY_COUNT);
+                const Pos pos2 = static_cast<Pos>(prng() % KEY_COUNT);
+                layout.swap2Keys(pos1, pos2);
+                REQUIRE_EQ(layout.getHash(), Layout(layout.toString()).getHash());
+            }
+        }
+    }
 }
 
 }
@@ -69,6 +69,50 @@ TEST_SUITE("Test layout::Manager") {
         CHECK_LT(num_duplicate_items, threshold);
     }
 
+    TEST_CASE("test layout::Manager::setSeed()") {
+        const auto createLayouts = [] -> std::vector<Layout> {
+            Manager m1, m2;
+            return {m1.create(), m2.create(), m1.create(), m2.create()};
+        };
+
+        // 相同的种子给出相同的布局序列, 不同的种子则不同
+        Manager::setSeed(42);
+        const std::vector<Layout> a = createLayouts();
+        Manager::setSeed(42);
+        const std::vector<Layout> b = createLayouts();
+        Manager::setSeed(43);
+        const std::vector<Layout> c = createLayouts();
+
+        // 从记录的状态恢复种子来源后, 接续给出相同的种子
+        Manager::setSeed(42);
+        Manager::nextSeed();
+        const auto [seed, index] = Manager::seedStream();
+        const uint64_t expected = Manager::nextSeed();
+        Manager::setSeed(std::nullopt);
+        Manager::setSeed(seed, index);
+        const uint64_t resumed = Manager::nextSeed();
+        Manager::setSeed(std::nullopt);
+
+        CHECK_EQ(a, b);
+        CHECK_NE(a, c);
+        CHECK_NE(a[0], a[1]);
+        CHECK_EQ(seed, 42);
+        CHECK_EQ(index, 1);
+        CHECK_EQ(resumed, expected);
+    }
+
+    TEST_CASE("test layout::Manager::canManage()") {
+        REQUIRE(manager.canManage(EXAMPLE));
+
+        // 交换两个固定按键不改变各可变区域的键值, 但布局不再与设置兼容
+        const std::vector<Key>& pinned_keys = Config::getInstance().pinnedKeys();
+        if (pinned_keys.size() >= 2) {
+            std::string seq = EXAMPLE.toString();
+            std::swap(seq[pinned_keys[0].pos], seq[pinned_keys[1].pos]);
+            CHECK_FALSE(manager.canManage(Layout(seq)));
+        }
+    }
+
     TEST_CASE("test layout::Manager::create()") {
         auto wrapper = [&]() -> Layout { return manager.create(); };
         checkRandomness(wrapper, 1000, 10);
@@ -110,6 +154,18 @@ TEST_SUITE("Test layout::Manager") {
             REQUIRE_EQ(munOfDiffKeys(layout, EXAMPLE), 2);
         }
 
+        SUBCASE("hash") {
+            Layout child = manager.create();
+            Layout parent = manager.create();
+            for (uz i = 0; i < 1000; ++i) {
+                manager.mutate(child, parent);
+                REQUIRE_EQ(child.getHash(), Layout(child.toString()).getHash());
+                std::swap(child, parent);
+            }
+            manager.reinit(child);
+            REQUIRE_EQ(child.getHash(), Layout(child.toString()).getHash());
+        }
+
         SUBCASE("verify randomness") {
             auto wrapper = [&]() -> Layout {
                 Layout layout = EXAMPLE;
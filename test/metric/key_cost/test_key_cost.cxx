@@ -35,6 +35,31 @@ TEST_CASE("test metric::KeyCost") {
         WARN_GT(flaws_q, flaws_d);
     }
 
+    SUBCASE("update()") {
+        Layout parent = manager.create();
+        Layout child = manager.create();
+        State state;
+        metric.analyze(parent, state);
+        for (uz i = 0; i < 1000; ++i) {
+            const auto [pos1, pos2] = manager.mutate(child, parent);
+            const auto [cost1, flaws1] = metric.update(child, pos1, pos2, state);
+            const auto [cost2, flaws2] = metric.analyze(child);
+            REQUIRE(cost1 == doctest::Approx(cost2).epsilon(1e-6));
+            REQUIRE_EQ(flaws1, flaws2);
+            parent = child;
+        }
+    }
+
+    SUBCASE("extremes()") {
+        const auto [min_cost, max_cost] = metric.extremes();
+        REQUIRE_LT(min_cost, max_cost);
+        for (uz i = 0; i < 1000; ++i) {
+            const fz cost = metric.measure(manager.create());
+            REQUIRE_LE(min_cost, doctest::Approx(cost));
+            REQUIRE_GE(max_cost, doctest::Approx(cost));
+        }
+    }
+
     SUBCASE("show costs of random layouts") {
         printTitle("Show metric::KeyCost results - random layouts:");
         for (uz i = 1; i <= 5; i++) {
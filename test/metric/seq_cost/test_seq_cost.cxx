@@ -35,6 +35,21 @@ TEST_CASE("test metric::SeqCost") {
         WARN_GT(flaws_q, flaws_d);
     }
 
+    SUBCASE("update()") {
+        Layout parent = manager.create();
+        Layout child = manager.create();
+        State state;
+        metric.analyze(parent, state);
+        for (uz i = 0; i < 1000; ++i) {
+            const auto [pos1, pos2] = manager.mutate(child, parent);
+            const auto [cost1, flaws1] = metric.update(child, pos1, pos2, state);
+            const auto [cost2, flaws2] = metric.analyze(child);
+            REQUIRE(cost1 == doctest::Approx(cost2).epsilon(1e-6));
+            REQUIRE_EQ(flaws1, flaws2);
+            parent = child;
+        }
+    }
+
     SUBCASE("show costs of random layouts") {
         printTitle("Show metric::SeqCost results - random layouts:");
         for (uz i = 1; i <= 5; i++) {
@@ -57,4 +72,84 @@ TEST_CASE("test metric::SeqCost") {
     }
 }
 
+TEST_CASE("test metric::SeqCost dense representation") {
+
+    // 覆盖全部 2-gram 与大量 3-gram 的语料, 记录数超过 MAX_RECORDS, 应当使用稠密表示
+    static const std::string D_PATH = Utils::absPath("cache/test_dense_seq.toml");
+    {
+        std::ofstream os(D_PATH, std::ios::out | std::ios::trunc);
+        os << "[bigram]\n";
+        for (uz a = 0; a < KEY_COUNT; ++a) {
+            for (uz b = 0; b < KEY_COUNT; ++b) {
+                os << std::format("\"{:c}{:c}\"={:.6f}\n", CAP_SET[a], CAP_SET[b], (1 + (a * 7 + b * 13) % 50) * 1e-4);
+            }
+        }
+        os << "\n[trigram]\n";
+        for (uz i = 0; i < 3000; ++i) {
+            const uz a = i % KEY_COUNT, b = i / KEY_COUNT % KEY_COUNT, c = (i / 900 * 11 + i * 7 + 3) % KEY_COUNT;
+            os << std::format("\"{:c}{:c}{:c}\"={:.6f}\n", CAP_SET[a], CAP_SET[b], CAP_SET[c], (1 + i % 37) * 1e-4);
+        }
+    }
+    const Toml toml = toml::parse<toml::ordered_type_config>(D_PATH);
+    std::filesystem::remove(D_PATH);
+
+    const Data data(toml);
+    REQUIRE(data.isDense());
+    SeqCost metric(data);
+    layout::Manager manager;
+    const Config& cfg = Config::getInstance();
+
+    SUBCASE("measure() covers all records") {
+        for (uz i = 0; i < 10; ++i) {
+            const Layout layout = manager.create();
+            fz expected = 0.0;
+            for (const auto& node : toml.at("bigram").as_table()) {
+                expected += static_cast<fz>(cfg.costOf(Bigram(node), layout)) * node.second.as_floating();
+            }
+            for (const auto& node : toml.at("trigram").as_table()) {
+                expected += static_cast<fz>(cfg.costOf(Trigram(node), layout)) * node.second.as_floating();
+            }
+            REQUIRE_EQ(metric.measure(layout), doctest::Approx(expected).epsilon(1e-9));
+        }
+    }
+
+    SUBCASE("update()") {
+        Layout parent = manager.create();
+        Layout child = manager.create();
+        State state;
+        metric.analyze(parent, state);
+        for (uz i = 0; i < 1000; ++i) {
+            const auto [pos1, pos2] = manager.mutate(child, parent);
+            const auto [cost1, flaws1] = metric.update(child, pos1, pos2, state);
+            const auto [cost2, flaws2] = metric.analyze(child);
+            REQUIRE(cost1 == doctest::Approx(cost2).epsilon(1e-6));
+            REQUIRE_EQ(flaws1, flaws2);
+            parent = child;
+        }
+    }
+
+    SUBCASE("update() keeps the cost matrix in sync") {
+        // 另一个实例只用于核对, 不与被测实例共享代价矩阵
+        SeqCost reference(data);
+        Layout parent = manager.create();
+        Layout child = manager.create();
+        State state;
+        for (uz i = 0; i < 100; ++i) {
+            // 交替地评估无关的布局, 与连续地交换按键
+            if (i % 10 == 0) {
+                metric.measure(manager.create());
+                parent = manager.create();
+                metric.analyze(parent, state);
+            }
+            const auto [pos1, pos2] = manager.mutate(child, parent);
+            const auto [cost1, flaws1] = metric.update(child, pos1, pos2, state);
+            const auto [cost2, flaws2] = reference.analyze(child);
+            REQUIRE(cost1 == doctest::Approx(cost2).epsilon(1e-6));
+            REQUIRE_EQ(flaws1, flaws2);
+            REQUIRE(metric.measure(child) == doctest::Approx(cost2).epsilon(1e-9));
+            parent = child;
+        }
+    }
+}
+
 }
@@ -0,0 +1,72 @@
+#include <doctest/doctest.h>
+
+#include "../../src/metric/key_cost/key_cost.hxx"
+#include "../../src/metric/dis_cost/dis_cost.hxx"
+#include "../../src/metric/seq_cost/seq_cost.hxx"
+#include "../../src/layout/layout_manager.hxx"
+#include "../test_utilities.hxx"
+
+namespace clubmoss::metric::corpus::test {
+
+TEST_SUITE("Test metric::Corpus") {
+
+    static constexpr auto PATH = "cache/test_corpus.bin";
+
+    static auto parse(const std::string_view sub_path) -> Toml {
+        return toml::parse<toml::ordered_type_config>(Utils::absPath(sub_path));
+    }
+
+    TEST_CASE("test Corpus::compile() and open()") {
+        static const Toml M_CFG = toml::parse(Utils::absPath("test/metric/metric.toml"));
+        static const Toml S_CFG = toml::parse(Utils::absPath("test/metric/score.toml"));
+        Config::loadCfg(M_CFG, S_CFG);
+
+        REQUIRE_NOTHROW(Corpus::compile(PATH));
+        const std::optional<Corpus> corpus = Corpus::open(PATH);
+        REQUIRE(corpus.has_value());
+
+        for (const Language language : Language::_values()) {
+            CHECK_EQ(corpus->records(language, Section::Chars).size(), KEY_COUNT);
+            CHECK_LE(corpus->records(language, Section::Pairs).size(), dis_cost::Data::MAX_RECORDS);
+            CHECK_LE(corpus->records(language, Section::Bigrams).size(), KEY_COUNT * KEY_COUNT);
+            CHECK_LE(corpus->records(language, Section::Trigrams).size(), KEY_COUNT * KEY_COUNT * KEY_COUNT);
+        }
+
+        // 由二进制语料与 TOML 文件构造的指标应当给出完全相同的结果
+        KeyCost kc1(key_cost::Data(parse("data/chinese/char.toml")));
+        KeyCost kc2(key_cost::Data(*corpus, Language::Chinese));
+        DisCost dc1(dis_cost::Data(parse("data/chinese/pair.toml")));
+        DisCost dc2(dis_cost::Data(*corpus, Language::Chinese));
+        SeqCost sc1(seq_cost::Data(parse("data/chinese/seq.toml")));
+        SeqCost sc2(seq_cost::Data(*corpus, Language::Chinese));
+
+        layout::Manager manager;
+        for (uz i = 0; i < 100; ++i) {
+            const Layout layout = manager.create();
+            REQUIRE_EQ(kc1.analyze(layout), kc2.analyze(layout));
+            REQUIRE_EQ(dc1.analyze(layout), dc2.analyze(layout));
+            REQUIRE_EQ(sc1.analyze(layout), sc2.analyze(layout));
+        }
+
+        std::filesystem::remove(Utils::absPath(PATH));
+    }
+
+    TEST_CASE("test Corpus::open() with a damaged file") {
+        REQUIRE_NOTHROW(Corpus::compile(PATH));
+        const std::string path = Utils::absPath(PATH);
+        {
+            std::fstream fs(path, std::ios::in | std::ios::out | std::ios::binary);
+            fs.seekp(-1, std::ios::end);
+            fs.put('\x7F');
+        }
+        CHECK_FALSE(Corpus::open(PATH).has_value());
+
+        std::filesystem::resize_file(path, 16);
+        CHECK_FALSE(Corpus::open(PATH).has_value());
+
+        std::filesystem::remove(path);
+        CHECK_FALSE(Corpus::open(PATH).has_value());
+    }
+}
+
+}
@@ -0,0 +1,101 @@
+#include <omp.h>
+#include <doctest/doctest.h>
+
+#include "../../../src/module/optimizer/annealer.hxx"
+#include "../../test_utilities.hxx"
+
+namespace clubmoss::optimizer::test {
+
+TEST_SUITE("Test optimizer::Annealer") {
+
+    // 缩短退火链, 并关闭检查点与穷举, 以免干扰其他测试
+    static auto testCfg() -> Toml {
+        Toml cfg = shippedSearchCfg();
+        cfg.at("annealing").at("chains_per_thread") = 2;
+        cfg.at("annealing").at("steps_per_chain") = 20000;
+        cfg.at("annealing").at("schedule") = "exponential";
+        cfg.at("annealing").at("initial_temperature") = 0.02;
+        cfg.at("annealing").at("final_temperature") = 0.00001;
+        cfg.at("checkpoint").at("enabled") = false;
+        cfg.at("checkpoint").at("resume") = false;
+        cfg.at("enumeration").at("max_permutations") = 0;
+        return cfg;
+    }
+
+    static const Toml CONFIG = testCfg();
+
+    class AnnealerWrapper : public Annealer {
+    public:
+        [[nodiscard]] auto getBests() const -> const std::vector<Sample>& {
+            return bests_;
+        }
+
+        [[nodiscard]] static auto getTemperature(const uz step) -> fz {
+            return temperatureAt(step);
+        }
+    };
+
+    TEST_CASE("test optimizer::Config::loadCfg(Toml)") {
+
+        SUBCASE("should pass") {
+            REQUIRE_NOTHROW(Config::loadCfg(CONFIG));
+        }
+
+        SUBCASE("should fail") {
+            printTitle("Show optimizer::Config::loadCfg(Toml) error messages:");
+            Toml bad_mode(CONFIG);
+            bad_mode.at("mode") = "genetic";
+            check([&] { Config::loadCfg(bad_mode); });
+
+            Toml bad_schedule(CONFIG);
+            bad_schedule.at("annealing").at("schedule") = "cubic";
+            check([&] { Config::loadCfg(bad_schedule); });
+
+            Toml bad_temperature(CONFIG);
+            bad_temperature.at("annealing").at("final_temperature") = 0.1;
+            check([&] { Config::loadCfg(bad_temperature); });
+        }
+        Config::loadCfg(shippedSearchCfg());
+    }
+
+    TEST_CASE("test optimizer::Annealer::temperatureAt()") {
+        Config::loadCfg(CONFIG);
+        for (const std::string schedule : {"exponential", "linear", "logarithmic"}) {
+            Toml cfg(CONFIG);
+            cfg.at("annealing").at("schedule") = schedule;
+            Config::loadCfg(cfg);
+            CHECK_EQ(AnnealerWrapper::getTemperature(0), doctest::Approx(0.02));
+            CHECK_EQ(AnnealerWrapper::getTemperature(20000), doctest::Approx(0.00001));
+            for (uz step = 1000; step <= 20000; step += 1000) {
+                CHECK_LE(AnnealerWrapper::getTemperature(step), AnnealerWrapper::getTemperature(step - 1000));
+            }
+        }
+        Config::loadCfg(shippedSearchCfg());
+    }
+
+    TEST_CASE("test optimizer::Annealer::search()") {
+        Config::loadCfg(CONFIG);
+        omp_set_num_threads(2);
+
+        AnnealerWrapper annealer;
+        const fz best_loss = annealer.search();
+        const std::vector<Sample>& bests = annealer.getBests();
+
+        REQUIRE_EQ(bests.size(), 4);
+        CHECK_EQ(best_loss, bests.front().getLoss());
+
+        Evaluator evaluator;
+        for (const Sample& best : bests) {
+            Sample sample(best);
+            evaluator.analyze(sample);
+            CHECK_EQ(sample.getLoss(), doctest::Approx(best.getLoss()).epsilon(1e-6));
+        }
+
+        Sample random(layout::Manager().create());
+        evaluator.analyze(random);
+        WARN_LT(best_loss, random.getLoss());
+        Config::loadCfg(shippedSearchCfg());
+    }
+}
+
+}
@@ -0,0 +1,58 @@
+#include <omp.h>
+#include <doctest/doctest.h>
+
+#include "../../../src/module/optimizer/enumerator.hxx"
+#include "../../../src/module/optimizer/branch_and_bound.hxx"
+#include "../../test_utilities.hxx"
+
+namespace clubmoss::optimizer::test {
+
+TEST_SUITE("Test optimizer::BranchAndBound") {
+
+    // 按代价分解计算的代价应当与指标本身的结果一致
+    template <typename Metric>
+    static auto checkDecomposition(Metric& metric) -> void {
+        const metric::Decomposition model = metric.decompose();
+        layout::Manager manager;
+        for (uz i = 0; i < 100; ++i) {
+            const Layout layout = manager.create();
+            fz cost = 0.0;
+            for (const metric::Term& term : model.terms) {
+                std::array<Pos, 3> pos{};
+                for (uz k = 0; k < term.size; ++k) {
+                    pos[k] = term.caps[k] == ' ' ? metric::Config::IDLE_POS : layout.getPos(term.caps[k]);
+                }
+                cost += term.freq * model.costOf(term, pos);
+            }
+            REQUIRE_EQ(cost, doctest::Approx(metric.measure(layout)));
+        }
+    }
+
+    TEST_CASE("test decompose()") {
+        for (const Language language : Language::_values()) {
+            metric::KeyCost kc(Resources::KC_DATA[language]);
+            metric::DisCost dc(Resources::DC_DATA[language]);
+            metric::SeqCost sc(Resources::SC_DATA[language]);
+            checkDecomposition(kc);
+            checkDecomposition(dc);
+            checkDecomposition(sc);
+        }
+    }
+
+    TEST_CASE("test optimizer::BranchAndBound::search()") {
+        layout::Manager::loadCfg(layout::smallLayoutCfg());
+        omp_set_num_threads(4);
+
+        // 分支定界应当在预算内完成搜索, 并给出与穷举相同的最优解
+        Enumerator enumerator;
+        const fz optimal_loss = enumerator.search();
+        BranchAndBound solver;
+        const fz best_loss = solver.search();
+        CHECK(solver.isCertified());
+        CHECK_EQ(best_loss, doctest::Approx(optimal_loss));
+
+        layout::Manager::loadCfg(toml::parse(Utils::absPath("conf/layout.toml")));
+    }
+}
+
+}
@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+
+#include "../../../src/module/optimizer/o_pool.hxx"
+#include "../../test_utilities.hxx"
+
+namespace clubmoss::checkpoint::test {
+
+TEST_SUITE("Test Checkpoint") {
+
+    static constexpr auto PATH = "cache/test.ckpt";
+
+    TEST_CASE("test Checkpoint round trip") {
+        const Checkpoint checkpoint(PATH, {"conf/layout.toml", "conf/metric.toml"});
+        const Layout layout = layout::Manager().create();
+        const std::array<fz, TASK_COUNT> costs{0.1, 0.2, 0.3, 0.4, 0.5, 0.6};
+
+        Checkpoint::Writer writer = checkpoint.writer();
+        writer.write(42uz).write(costs).write(layout);
+        REQUIRE(writer.commit());
+
+        std::optional<Checkpoint::Reader> reader = checkpoint.reader();
+        REQUIRE(reader.has_value());
+        uz value{};
+        std::array<fz, TASK_COUNT> loaded_costs{};
+        Layout loaded = layout::baselines::ALL.front();
+        reader->read(value).read(loaded_costs).read(loaded);
+        CHECK_EQ(value, 42);
+        CHECK_EQ(loaded_costs, costs);
+        CHECK_EQ(loaded, layout);
+        CHECK_EQ(loaded.getHash(), layout.getHash());
+        CHECK_THROWS_AS(reader->read(value), FatalError);
+
+        checkpoint.remove();
+        CHECK_FALSE(checkpoint.reader().has_value());
+    }
+
+    TEST_CASE("test Checkpoint fingerprint") {
+        const Checkpoint old_checkpoint(PATH, {"conf/layout.toml"});
+        const Checkpoint new_checkpoint(PATH, {"conf/layout.toml", "conf/metric.toml"});
+
+        Checkpoint::Writer writer = old_checkpoint.writer();
+        writer.write(42uz);
+        REQUIRE(writer.commit());
+
+        CHECK(old_checkpoint.reader().has_value());
+        CHECK_FALSE(new_checkpoint.reader().has_value());
+        old_checkpoint.remove();
+    }
+
+    TEST_CASE("test optimizer::Pool::save() and load()") {
+        const Checkpoint checkpoint(PATH, {"conf/layout.toml"});
+        optimizer::Pool pool, restored;
+        pool.setSize(200);
+        pool.start();
+        for (uz epoch = 0; epoch < 10 and pool.step(); ++epoch) {}
+
+        Checkpoint::Writer writer = checkpoint.writer();
+        pool.save(writer);
+        REQUIRE(writer.commit());
+
+        std::optional<Checkpoint::Reader> reader = checkpoint.reader();
+        REQUIRE(reader.has_value());
+        restored.load(*reader);
+        checkpoint.remove();
+
+        std::vector<Layout> expected(100, layout::baselines::ALL.front());
+        std::vector<Layout> actual(100, layout::baselines::ALL.front());
+        pool.emigrate(expected);
+        restored.emigrate(actual);
+        CHECK_EQ(actual, expected);
+    }
+}
+
+}
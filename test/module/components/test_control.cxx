@@ -0,0 +1,74 @@
+#include <omp.h>
+#include <doctest/doctest.h>
+
+#include "../../../src/module/optimizer/o_pool.hxx"
+#include "../../test_utilities.hxx"
+
+namespace clubmoss::optimizer::test {
+
+TEST_SUITE("Test optimizer::Control") {
+
+    TEST_CASE("test unbounded control") {
+        const Control control;
+        control.consume(1'000);
+        CHECK_FALSE(control.stopRequested());
+        CHECK_FALSE(control.isBounded());
+        CHECK_EQ(control.evaluations(), 0);
+        CHECK_EQ(control.progress(), 0.0);
+    }
+
+    TEST_CASE("test evaluation budget") {
+        Control control;
+        control.setEvaluationBudget(1'000);
+        REQUIRE(control.isBounded());
+
+        // 副本之间共享评估计数
+        const Control copy = control;
+        copy.consume(400);
+        CHECK_EQ(control.evaluations(), 400);
+        CHECK_EQ(control.progress(), doctest::Approx(0.4));
+        CHECK_FALSE(control.stopRequested());
+
+        // 剩余的 600 次评估分为 3 份
+        const Control share = control.fairShare(3);
+        share.consume(150);
+        CHECK_EQ(share.progress(), doctest::Approx(0.75));
+        CHECK_FALSE(share.stopRequested());
+        share.consume(50);
+        CHECK(share.stopRequested());
+        CHECK_FALSE(control.stopRequested());
+
+        control.consume(400);
+        CHECK(control.stopRequested());
+    }
+
+    TEST_CASE("test deadline") {
+        Control control;
+        control.setDeadline(Control::Clock::now() + std::chrono::hours(1));
+        CHECK_FALSE(control.stopRequested());
+        CHECK_LT(control.fairShare(4).progress(), 0.01);
+
+        control.setDeadline(Control::Clock::now());
+        CHECK(control.stopRequested());
+        CHECK(control.fairShare(4).stopRequested());
+    }
+
+    TEST_CASE("test optimizer::Pool::search() within an evaluation budget") {
+        omp_set_num_threads(4);
+        Control control;
+        control.setEvaluationBudget(1200 + 600 * 10);
+
+        Pool pool;
+        pool.setSize(1200);
+        pool.setControl(control);
+        const fz loss = pool.search();
+
+        // 初始化评估全部样本, 此后每一代评估一半, 因此在第 10 代之后停止; 去重时重新评估的样本同样计入
+        CHECK_GE(control.evaluations(), 1200 + 600 * 10);
+        CHECK_LT(control.evaluations(), 1200 + 600 * 11);
+        CHECK(control.stopRequested());
+        CHECK_LT(loss, std::numeric_limits<fz>::max());
+    }
+}
+
+}
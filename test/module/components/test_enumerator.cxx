@@ -0,0 +1,68 @@
+#include <omp.h>
+#include <doctest/doctest.h>
+
+#include "../../../src/module/optimizer/enumerator.hxx"
+#include "../../test_utilities.hxx"
+
+namespace clubmoss::optimizer::test {
+
+TEST_SUITE("Test optimizer::Enumerator") {
+
+    class EnumeratorWrapper : public Enumerator {
+    public:
+        [[nodiscard]] auto getBests() const -> const std::vector<Sample>& {
+            return bests_;
+        }
+    };
+
+    TEST_CASE("test optimizer::Permutation::next()") {
+        for (uz n = 1; n <= 6; ++n) {
+            std::vector<Pos> positions(n);
+            std::iota(positions.begin(), positions.end(), Pos{0});
+            Permutation perm(positions);
+
+            for (uz cycle = 0; cycle < 2; ++cycle) {
+                std::vector<uz> arrangement(n);
+                std::iota(arrangement.begin(), arrangement.end(), 0uz);
+                std::set<std::vector<uz>> visited{arrangement};
+                while (const auto swapped = perm.next()) {
+                    std::swap(arrangement[swapped->first], arrangement[swapped->second]);
+                    visited.insert(arrangement);
+                }
+                // 每一轮都恰好经过全部 n! 种排列
+                uz factorial = 1;
+                for (uz k = 2; k <= n; ++k) factorial *= k;
+                REQUIRE_EQ(visited.size(), factorial);
+            }
+        }
+    }
+
+    TEST_CASE("test optimizer::Enumerator::search()") {
+        layout::Manager::loadCfg(layout::smallLayoutCfg());
+        omp_set_num_threads(4);
+        REQUIRE_EQ(Enumerator::countPermutations(), 576);
+
+        EnumeratorWrapper enumerator;
+        const fz best_loss = enumerator.search();
+        const std::vector<Sample>& bests = enumerator.getBests();
+        REQUIRE_EQ(bests.size(), 30);
+        CHECK(std::ranges::is_sorted(bests, {}, [](const Sample& s) { return s.getLoss(); }));
+        CHECK_EQ(best_loss, bests.front().getLoss());
+
+        // 穷举的结果不应劣于任何一个随机布局
+        Evaluator evaluator;
+        layout::Manager manager;
+        std::set<Hash> hashes;
+        for (uz i = 0; i < 20000; ++i) {
+            Sample sample(manager.create());
+            evaluator.analyze(sample);
+            hashes.insert(sample.getHash());
+            REQUIRE_LE(best_loss, doctest::Approx(sample.getLoss()));
+        }
+        CHECK_EQ(hashes.size(), 576);
+
+        layout::Manager::loadCfg(toml::parse(Utils::absPath("conf/layout.toml")));
+    }
+}
+
+}
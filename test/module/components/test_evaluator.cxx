@@ -13,6 +13,18 @@ TEST_SUITE("Test Evaluator") {
         REQUIRE_NOTHROW(Evaluator());
     }
 
+    TEST_CASE("test sharing metric data between evaluators") {
+        const auto& data = Resources::SC_DATA[Language::English];
+        const long count = data.use_count();
+        {
+            const Evaluator e1;
+            const Evaluator e2(e1); // NOLINT(*-unnecessary-copy-initialization)
+            // 每个评估器只持有一个引用, 而不是一份语料数据的副本
+            CHECK_EQ(data.use_count(), count + 2);
+        }
+        CHECK_EQ(data.use_count(), count);
+    }
+
     layout::Manager manager;
     Evaluator evaluator;
 
@@ -46,6 +58,94 @@ TEST_SUITE("Test Evaluator") {
         }
     }
 
+    TEST_CASE("test Evaluator::update(Sample)") {
+        Sample parent(manager.create());
+        Sample child(manager.create());
+        evaluator.analyze(parent);
+        for (uz i = 0; i < 1000; ++i) {
+            const auto [pos1, pos2] = manager.mutate(child, parent);
+            evaluator.update(child, parent, pos1, pos2);
+            const fz loss1 = child.getLoss();
+            const uz flaws1 = child.getFlaws();
+            evaluator.analyze(child);
+            REQUIRE_EQ(child.getLoss(), doctest::Approx(loss1).epsilon(1e-6));
+            REQUIRE_EQ(child.getFlaws(), flaws1);
+            std::swap(parent, child);
+        }
+    }
+
+    TEST_CASE("test Evaluator::measureBatch()") {
+        std::vector<Layout> layouts;
+        for (uz i = 0; i < 100; ++i) {
+            layouts.emplace_back(manager.create());
+        }
+        std::vector<fz> losses(layouts.size());
+        evaluator.measureBatch(layouts, losses);
+        for (uz i = 0; i < layouts.size(); ++i) {
+            Sample sample(layouts[i]);
+            evaluator.measure(sample);
+            REQUIRE_EQ(losses[i], doctest::Approx(sample.getLoss()).epsilon(1e-9));
+        }
+    }
+
+    TEST_CASE("test Evaluator::analyzeBatch()") {
+        std::vector<Layout> layouts;
+        for (uz i = 0; i < 100; ++i) {
+            layouts.emplace_back(manager.create());
+        }
+        std::vector<fz> losses(layouts.size());
+        std::vector<fz> raw_costs(layouts.size() * TASK_COUNT);
+        std::vector<uz> flaws(layouts.size());
+        evaluator.analyzeBatch(layouts, losses, raw_costs, flaws);
+        for (uz i = 0; i < layouts.size(); ++i) {
+            Sample sample(layouts[i]);
+            evaluator.analyze(sample);
+            REQUIRE_EQ(losses[i], doctest::Approx(sample.getLoss()).epsilon(1e-9));
+            REQUIRE_EQ(flaws[i], sample.getFlaws());
+        }
+    }
+
+    TEST_CASE("test Evaluator with Population") {
+        Population population;
+        population.resize(100, manager.create());
+        for (uz i = 0; i < population.size(); ++i) {
+            manager.reinit(population.layout(i));
+            evaluator.analyze(population, i);
+            Sample sample(population.layout(i));
+            evaluator.analyze(sample);
+            REQUIRE_EQ(population.loss(i), doctest::Approx(sample.getLoss()).epsilon(1e-9));
+            REQUIRE_EQ(population.flaws(i), sample.getFlaws());
+        }
+        for (uz i = 1; i < population.size(); ++i) {
+            const auto [pos1, pos2] = manager.mutate(population.layout(i), population.layout(i - 1));
+            evaluator.update(population, i, i - 1, pos1, pos2);
+            const fz loss = population.loss(i);
+            evaluator.analyze(population, i);
+            REQUIRE_EQ(population.loss(i), doctest::Approx(loss).epsilon(1e-6));
+        }
+        population.sort(std::less{});
+        for (uz rank = 1; rank < population.size(); ++rank) {
+            CHECK_LE(population.loss(population.indexOf(rank - 1)), population.loss(population.indexOf(rank)));
+        }
+    }
+
+    TEST_CASE("test Evaluator single-task dispatch") {
+        Sample parent(manager.create());
+        Sample child(manager.create());
+        for (uz task_id = 0; task_id < TASK_COUNT; ++task_id) {
+            evaluator.measure(parent, task_id);
+            const fz loss1 = parent.getLoss();
+            evaluator.analyze(parent, task_id);
+            CHECK_EQ(parent.getLoss(), doctest::Approx(loss1).epsilon(1e-6));
+
+            const auto [pos1, pos2] = manager.mutate(child, parent);
+            evaluator.update(child, parent, pos1, pos2, task_id);
+            const fz loss2 = child.getLoss();
+            evaluator.analyze(child, task_id);
+            CHECK_EQ(child.getLoss(), doctest::Approx(loss2).epsilon(1e-6));
+        }
+    }
+
     TEST_CASE("test multi-threaded Evaluator::evaluate(Layout)") {
 
         std::vector<std::unique_ptr<Sample>> samples;
@@ -0,0 +1,85 @@
+#include <omp.h>
+#include <doctest/doctest.h>
+
+#include "../../../src/module/extractor/extractor.hxx"
+#include "../../test_utilities.hxx"
+
+namespace clubmoss::extractor::test {
+
+TEST_SUITE("Test Extractor") {
+
+    static constexpr auto TEXT = "Hello, World; hello.\n你好 Wor\tld!";
+
+    static auto readAll(const std::string_view sub_path) -> std::string {
+        std::ifstream is(Utils::absPath(sub_path), std::ios::in | std::ios::binary);
+        return {std::istreambuf_iterator<char>(is), {}};
+    }
+
+    TEST_CASE("test Extractor::feed() and save()") {
+        Extractor extractor;
+        extractor.feed(TEXT);
+        extractor.save("cache/test_extractor");
+
+        const Toml chars = toml::parse<toml::ordered_type_config>(Utils::absPath("cache/test_extractor/char.toml"));
+        const Toml pairs = toml::parse<toml::ordered_type_config>(Utils::absPath("cache/test_extractor/pair.toml"));
+        const Toml seqs = toml::parse<toml::ordered_type_config>(Utils::absPath("cache/test_extractor/seq.toml"));
+
+        // 共 23 个合法的键值, 其中 'l' 出现 6 次
+        CHECK_EQ(chars.size(), KEY_COUNT);
+        CHECK_EQ(chars.at("l").as_floating(), doctest::Approx(6.0 / 23.0).epsilon(1e-5));
+        CHECK_EQ(chars.at("z").as_floating(), 0.0);
+
+        // 按键对包括单词的开头与结尾, 连续的分隔符只算一次
+        CHECK(pairs.contains(" h"));
+        CHECK(pairs.contains(" w"));
+        CHECK(pairs.contains("o,"));
+        CHECK(pairs.contains("r "));
+        CHECK(pairs.contains("d "));
+        CHECK(pairs.contains(". "));
+        CHECK_FALSE(pairs.contains(".w"));
+
+        CHECK(seqs.at("bigram").contains("ll"));
+        CHECK(seqs.at("trigram").contains("llo"));
+        CHECK_FALSE(seqs.at("trigram").contains("o,w"));
+
+        std::filesystem::remove_all(Utils::absPath("cache/test_extractor"));
+    }
+
+    TEST_CASE("test Extractor chunk and thread invariance") {
+        std::set<std::string> outputs;
+        for (uz threads = 1; threads <= 4; ++threads) {
+            omp_set_num_threads(static_cast<int>(threads));
+            for (uz chunk = 1; chunk <= 7; chunk += 3) {
+                Extractor extractor;
+                const std::string_view text(TEXT);
+                for (uz p = 0; p < text.size(); p += chunk) {
+                    extractor.feed(text.substr(p, chunk));
+                }
+                extractor.save("cache/test_extractor");
+                outputs.insert(
+                    readAll("cache/test_extractor/char.toml") +
+                    readAll("cache/test_extractor/pair.toml") +
+                    readAll("cache/test_extractor/seq.toml")
+                );
+            }
+        }
+        CHECK_EQ(outputs.size(), 1);
+        std::filesystem::remove_all(Utils::absPath("cache/test_extractor"));
+    }
+
+    TEST_CASE("test Extractor::ingest()") {
+        const std::string path = Utils::absPath("cache/test_extractor.txt");
+        {
+            std::ofstream os(path, std::ios::out | std::ios::binary);
+            for (uz i = 0; i < 1000; ++i) {
+                os << TEXT << '\n';
+            }
+        }
+        Extractor extractor;
+        REQUIRE_NOTHROW(extractor.ingest(path));
+        CHECK_THROWS_AS(extractor.ingest(path + ".missing"), FatalError);
+        std::filesystem::remove(path);
+    }
+}
+
+}
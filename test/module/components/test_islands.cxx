@@ -0,0 +1,68 @@
+#include <omp.h>
+#include <doctest/doctest.h>
+
+#include "../../../src/module/optimizer/islands.hxx"
+#include "../../test_utilities.hxx"
+
+namespace clubmoss::optimizer::test {
+
+TEST_SUITE("Test optimizer::Islands") {
+
+    // 3 个较小的岛屿, 并关闭检查点与穷举, 以免干扰其他测试
+    static auto testCfg() -> Toml {
+        Toml cfg = shippedSearchCfg();
+        cfg.at("islands").at("count") = 3;
+        cfg.at("islands").at("pool_size") = 200;
+        cfg.at("islands").at("migration_interval") = 5;
+        cfg.at("islands").at("migrants") = 2;
+        cfg.at("checkpoint").at("enabled") = false;
+        cfg.at("checkpoint").at("resume") = false;
+        cfg.at("enumeration").at("max_permutations") = 0;
+        return cfg;
+    }
+
+    static const Toml CONFIG = testCfg();
+
+    TEST_CASE("test optimizer::Mailbox") {
+        Config::loadCfg(CONFIG);
+        Pool sender, receiver;
+        sender.setSize(200);
+        receiver.setSize(200);
+        sender.start();
+        receiver.start();
+
+        Mailbox mailbox(2, layout::Manager().create());
+        CHECK_FALSE(mailbox.deliver(receiver));
+        CHECK(mailbox.post(sender));
+        CHECK_FALSE(mailbox.post(sender)); // 尚未送达, 放弃投递
+        CHECK(mailbox.deliver(receiver));
+        CHECK_FALSE(mailbox.deliver(receiver));
+        CHECK(mailbox.post(sender));
+        Config::loadCfg(shippedSearchCfg());
+    }
+
+    TEST_CASE("test optimizer::Islands::search()") {
+        Config::loadCfg(CONFIG);
+        omp_set_num_threads(3);
+
+        Islands islands;
+        REQUIRE_EQ(islands.size(), 3);
+
+        std::set<uz> rounds;
+        fz min_loss = std::numeric_limits<fz>::max();
+        const fz best_loss = islands.search(
+            6, 100,
+            [&](const Pool&, const uz island, const uz round, const fz loss, const fz best) {
+                CHECK_LT(island, 3);
+                rounds.insert(round);
+                min_loss = std::min(min_loss, loss);
+                CHECK_EQ(best, min_loss);
+            }
+        );
+        CHECK_EQ(rounds.size(), 6);
+        CHECK_EQ(best_loss, min_loss);
+        Config::loadCfg(shippedSearchCfg());
+    }
+}
+
+}
@@ -10,12 +10,20 @@ TEST_SUITE("Test optimizer::Pool") {
 
     class PoolWrapper : public Pool {
     public:
-        auto getBestSample() const -> Sample& {
-            return *samples_.front();
+        auto getBestSample() const -> Sample {
+            return population_.toSample(population_.indexOf(0));
         }
 
         auto getBestLoss() const -> fz {
-            return samples_.front()->getLoss();
+            return population_.loss(population_.indexOf(0));
+        }
+
+        auto getWorkerCount() const -> uz {
+            return workers_.size();
+        }
+
+        auto getCurrEpoch() const -> uz {
+            return curr_epoch_;
         }
     };
 
@@ -37,6 +45,50 @@ TEST_SUITE("Test optimizer::Pool") {
         WARN_NE(l1, l2);
     }
 
+    TEST_CASE("test reusing worker contexts") {
+        omp_set_num_threads(4);
+        pool.search();
+        const uz count = pool.getWorkerCount();
+        REQUIRE_GE(count, 1);
+        REQUIRE_LE(count, 4);
+
+        // 后续的搜索不应再构造新的工作上下文
+        pool.search();
+        CHECK_EQ(pool.getWorkerCount(), count);
+    }
+
+    TEST_CASE("test stopping optimizer::Pool::search()") {
+        std::stop_source source;
+        pool.setControl(Control(source.get_token()));
+        source.request_stop();
+
+        // 已请求停止时, 搜索在第一代开始前结束, 但仍然返回初始样本中的最优损失
+        const fz loss = pool.search();
+        CHECK_EQ(pool.getCurrEpoch(), 0);
+        CHECK_EQ(loss, pool.getBestLoss());
+
+        pool.setControl(Control());
+        pool.search();
+        CHECK_GT(pool.getCurrEpoch(), 0);
+    }
+
+    TEST_CASE("test warm start from known layouts") {
+        omp_set_num_threads(4);
+        pool.search();
+        const Sample known = pool.getBestSample();
+
+        // 已知布局原样进入初始样本, 因此新一轮搜索从不差于它的损失开始
+        PoolWrapper warm;
+        warm.setSize(1200);
+        warm.setSeeds({Layout(known.toString())});
+        warm.start();
+        CHECK_LE(warm.getBestLoss(), doctest::Approx(known.getLoss()));
+
+        warm.setSeeds({});
+        warm.start();
+        WARN_GT(warm.getBestLoss(), known.getLoss());
+    }
+
     TEST_CASE("show best sample in pools") {
         printTitle("Show best sample in pools:");
         for (uz i = 1; i <= 5; i++) {
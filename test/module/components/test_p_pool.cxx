@@ -10,12 +10,12 @@ TEST_SUITE("Test preprocessor::Pool") {
 
     class PoolWrapper : public Pool {
     public:
-        [[nodiscard]] auto getBestSample() const -> Sample& {
-            return *samples_.front();
+        [[nodiscard]] auto getBestSample() const -> Sample {
+            return population_.toSample(population_.indexOf(0));
         }
 
         [[nodiscard]] auto getBestLoss() const -> fz {
-            return samples_.front()->getLoss();
+            return population_.loss(population_.indexOf(0));
         }
 
         [[nodiscard]] auto getCurr() const -> uz {
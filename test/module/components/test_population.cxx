@@ -0,0 +1,81 @@
+#include <omp.h>
+#include <doctest/doctest.h>
+
+#include "../../../src/module/evaluator/evaluator.hxx"
+#include "../../../src/layout/layout_manager.hxx"
+
+namespace clubmoss::population::test {
+
+TEST_SUITE("Test Population") {
+
+    layout::Manager manager;
+    Evaluator evaluator;
+
+    auto createPopulation(const uz size) -> Population {
+        Population population;
+        population.resize(size, manager.create());
+        for (uz i = 0; i < size; ++i) {
+            manager.reinit(population.layout(i));
+            evaluator.analyze(population, i);
+        }
+        return population;
+    }
+
+    auto isSorted(const Population& population, const auto comp) -> bool {
+        for (uz rank = 1; rank < population.size(); ++rank) {
+            const fz prev = population.loss(population.indexOf(rank - 1));
+            const fz curr = population.loss(population.indexOf(rank));
+            if (comp(curr, prev)) return false;
+        }
+        return true;
+    }
+
+    auto isPermutation(const Population& population) -> bool {
+        std::vector<bool> seen(population.size(), false);
+        for (uz rank = 0; rank < population.size(); ++rank) {
+            const uz i = population.indexOf(rank);
+            if (i >= population.size() or seen[i]) return false;
+            seen[i] = true;
+        }
+        return true;
+    }
+
+    TEST_CASE("test Population::sort()") {
+        for (const uz size : {100uz, 4800uz}) {
+            for (const int threads : {1, 4}) {
+                omp_set_num_threads(threads);
+                Population population = createPopulation(size);
+                population.sort(std::less{});
+                CHECK(isSorted(population, std::less{}));
+                CHECK(isPermutation(population));
+                population.sort(std::greater{});
+                CHECK(isSorted(population, std::greater{}));
+                CHECK(isPermutation(population));
+            }
+        }
+    }
+
+    TEST_CASE("test Population::select()") {
+        for (const uz size : {100uz, 4800uz}) {
+            for (const int threads : {1, 4}) {
+                omp_set_num_threads(threads);
+                Population population = createPopulation(size);
+                population.sort(std::less{});
+                const uz half = size / 2;
+                for (uz epoch = 0; epoch < 10; ++epoch) {
+                    for (uz rank = half; rank < size; ++rank) {
+                        const uz parent = population.indexOf(rank - half);
+                        const uz child = population.indexOf(rank);
+                        const auto [pos1, pos2] = manager.mutate(population.layout(child), population.layout(parent));
+                        evaluator.update(population, child, parent, pos1, pos2);
+                    }
+                    population.select(half, std::less{});
+                    REQUIRE(isSorted(population, std::less{}));
+                    REQUIRE(isPermutation(population));
+                }
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,46 @@
+#include <omp.h>
+#include <doctest/doctest.h>
+
+#include "../../../src/module/optimizer/o_pool.hxx"
+#include "../../test_utilities.hxx"
+
+namespace clubmoss::telemetry::test {
+
+TEST_SUITE("Test telemetry::Telemetry") {
+
+    TEST_CASE("test optimizer::Pool telemetry") {
+        omp_set_num_threads(4);
+        std::vector<Report> reports;
+        Telemetry::setCallback([&reports](const Report& report) -> void { reports.push_back(report); });
+        REQUIRE(Telemetry::enabled());
+
+        optimizer::Pool pool;
+        pool.setSize(1200);
+        pool.search();
+        Telemetry::setCallback(nullptr);
+        REQUIRE_FALSE(Telemetry::enabled());
+
+        REQUIRE_GE(reports.size(), 2);
+        const Report& summary = reports.back();
+        CHECK_EQ(summary.kind, +ReportKind::Pool);
+        CHECK_EQ(reports.size(), summary.epoch + 1);
+
+        // 每一代的计数之和等于整轮的计数: 初始化评估全部样本, 此后每一代评估一半
+        Counters total;
+        for (uz i = 0; i + 1 < reports.size(); ++i) {
+            CHECK_EQ(reports[i].kind, +ReportKind::Epoch);
+            CHECK_EQ(reports[i].epoch, i + 1);
+            total.merge(reports[i].counters);
+        }
+        CHECK_EQ(total.calls, summary.counters.calls);
+        CHECK_EQ(total.evaluations, summary.counters.evaluations);
+        CHECK_EQ(summary.counters.calls[Probe::Analyze], 1200 + 600 * summary.epoch);
+        // 评估数还包括去重时重新评估的样本
+        CHECK_GE(summary.counters.evaluations, summary.counters.calls[Probe::Analyze]);
+        CHECK_EQ(summary.counters.calls[Probe::Sort], summary.epoch);
+        CHECK_EQ(summary.counters.calls[Probe::Unique], summary.epoch / 5);
+        CHECK_GT(summary.counters.nanos[Probe::Analyze], 0);
+    }
+}
+
+}
@@ -73,6 +73,13 @@ static auto collectTestFiles(
 }
 
 
+namespace optimizer {
+    // 随附的搜索设置; 测试在其基础上只覆盖需要的字段, 并在结束时重新加载它
+    static auto shippedSearchCfg() -> Toml {
+        return toml::parse<toml::ordered_type_config>(Utils::absPath("conf/search.toml"));
+    }
+}
+
 namespace layout {
     static auto munOfDiffKeys(const Layout& lyt1, const Layout& lyt2) -> uz {
         uz counter = 0;
@@ -84,6 +91,21 @@ namespace layout {
         }
         return counter;
     }
+
+    // 固定 QWERTY 中除 ASDF 与 CVBN 以外的 22 个按键, 共 4! x 4! 种排列
+    static auto smallLayoutCfg() -> Toml {
+        static constexpr std::string_view QWERTY{"QWERTYUIOPASDFGHJKL;ZXCVBNM,./"};
+        std::string cfg = R"(
+            [[mutable_areas]]
+            cap_list = ["A", "S", "D", "F"]
+            pos_list = [10, 11, 12, 13]
+        )";
+        for (uz pos = 0; pos < KEY_COUNT; ++pos) {
+            if ((10 <= pos and pos <= 13) or (22 <= pos and pos <= 25)) continue;
+            cfg += std::format("[[pinned_keys]]\ncap = \"{:c}\"\npos = {:d}\n", QWERTY[pos], pos);
+        }
+        return toml::parse_str(cfg);
+    }
 }
 
 }